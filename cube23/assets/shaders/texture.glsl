@@ -6,8 +6,11 @@
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec2 a_texCoord;
 
-uniform mat4 u_viewProjection;
-uniform mat4 u_transform;
+layout(std140) uniform Scene {
+    mat4 u_viewProjection;
+};
+
+#pragma vox draw_data
 
 out vec2 v_texCoord;
 
@@ -1,13 +1,20 @@
 #include <Vox.h>
 
+#include <filesystem>
+
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "platform/opengl/shader.h"
 
 class Cube final : public Vox::Application {
 public:
-    Cube() : Application("Cube23"), mCamera(-1.6f, 1.6f, -0.9f, 0.9f), mCameraPosition(0.0f) {
-        mVertexArray.reset(Vox::VertexArray::create());
+    Cube() : Application("Cube23", true), mCamera(-1.6f, 1.6f, -0.9f, 0.9f), mCameraPosition(0.0f) {
+        // Loose files next to the executable are still used for anything the archive does not contain
+        if (std::filesystem::exists("assets.pak")) {
+            Vox::VFS::mount("assets.pak");
+        }
+
+        mVertexArray = Vox::VertexArray::create();
 
         float vertices[5 * 4] = {
             -0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
@@ -16,8 +23,7 @@ public:
             -0.5f,  0.5f, 0.0f, 0.0f, 1.0f
         };
 
-        std::shared_ptr<Vox::VertexBuffer> vertexBuffer;
-        vertexBuffer.reset(Vox::VertexBuffer::create(vertices, sizeof(vertices)));
+        const auto vertexBuffer = Vox::VertexBuffer::create(vertices, sizeof(vertices));
         const Vox::BufferLayout layout = {
             { Vox::ShaderDataType::Float3, "a_position" },
             { Vox::ShaderDataType::Float2, "a_texCoord" }
@@ -26,22 +32,35 @@ public:
         mVertexArray->addVertexBuffer(vertexBuffer);
 
         uint32_t indices[6] = {0, 1, 2, 2, 3, 0};
-        std::shared_ptr<Vox::IndexBuffer> indexBuffer;
-        indexBuffer.reset(Vox::IndexBuffer::create(indices, sizeof(indices) / sizeof(uint32_t)));
+        const auto indexBuffer = Vox::IndexBuffer::create(indices, sizeof(indices) / sizeof(uint32_t));
         mVertexArray->setIndexBuffer(indexBuffer);
 
-        const auto shader = mShaderLibrary.load("shaders/texture.glsl");
+        // Compiles in the background while the textures below are loaded; the first bind collects it
+        const auto shader = mShaderLibrary.loadAsync({ "shaders/texture.glsl" }).front();
 
-        mTexture = Vox::Texture2D::create("textures/texture.jpg");
-        mYingaTexture = Vox::Texture2D::create("textures/yinga.png");
+        mYingaTexture = mAssets.loadTexture("textures/yinga.vxt", {}, true);
+
+        // Both images share one texture array, so the grid below stays a single draw call
+        Vox::TextureAtlasSpec atlasSpec;
+        atlasSpec.pageSize = 1024;
+        mAtlas = std::make_unique<Vox::TextureAtlas>(atlasSpec);
+        mAtlas->add("texture", "textures/texture.jpg");
+        mAtlas->add("yinga", "textures/yinga.png");
+        mAtlas->build();
 
         shader->bind();
         shader->setInt("u_texture", 0);
+
+        // Camera movement is simulated at a fixed rate and interpolated for rendering
+        setFixedTimestep(1.0 / 120.0);
     }
 
     ~Cube() {}
 
-    void onUpdate(const Vox::Timestep ts) override {
+    void onFixedUpdate(const Vox::Timestep ts) override {
+        mPreviousCameraPosition = mCameraPosition;
+        mPreviousCameraRotation = mCameraRotation;
+
         if (Vox::Input::isKeyPressed(VX_KEY_LEFT))
             mCameraPosition.x -= mCameraMoveSpeed * ts;
         else if (Vox::Input::isKeyPressed(VX_KEY_RIGHT))
@@ -56,44 +75,53 @@ public:
             mCameraRotation += mCameraRotationSpeed * ts;
         else if (Vox::Input::isKeyPressed(VX_KEY_D))
             mCameraRotation -= mCameraRotationSpeed * ts;
+    }
 
+    void onUpdate(const Vox::Timestep ts) override {
         Vox::RenderCommand::setClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
         Vox::RenderCommand::clear();
 
-        mCamera.setPosition(mCameraPosition);
-        mCamera.setRotation(mCameraRotation);
+        const float alpha = ts.getAlpha();
+        mCamera.setPosition(glm::mix(mPreviousCameraPosition, mCameraPosition, alpha));
+        mCamera.setRotation(glm::mix(mPreviousCameraRotation, mCameraRotation, alpha));
 
         Vox::Renderer::beginScene(mCamera);
 
         const auto shader = mShaderLibrary.get("texture");
 
-        mTexture->bind(0);
-
-        const glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(0.1f));
+        Vox::Renderer2D::resetStats();
+        Vox::Renderer2D::beginScene(mCamera);
+        const auto &atlasTexture = mAtlas->getTexture();
+        const auto &textureRegion = mAtlas->getRegion("texture");
+        const auto &yingaRegion = mAtlas->getRegion("yinga");
         for (int y = 0; y < 20; y++) {
             for (int x = 0; x < 20; x++) {
                 glm::vec3 pos(x * 0.11f, y * 0.11f, 0.0f);
-                glm::mat4 transform = translate(glm::mat4(1.0f), pos) * scale;
-                Vox::Renderer::submit(shader, mVertexArray, transform);
+                Vox::Renderer2D::drawQuad(pos, glm::vec2(0.1f), 0.0f, atlasTexture,
+                                          (x + y) % 2 ? yingaRegion : textureRegion);
             }
         }
+        Vox::Renderer2D::endScene();
 
-        mYingaTexture->bind(0);
-        Vox::Renderer::submit(shader, mVertexArray);
+        Vox::Renderer::submit(shader, mVertexArray, glm::mat4(1.0f), mYingaTexture);
 
         Vox::Renderer::endScene();
     }
 
 private:
     Vox::ShaderLibrary mShaderLibrary;
+    Vox::AssetManager mAssets;
     std::shared_ptr<Vox::VertexArray> mVertexArray;
 
-    std::shared_ptr<Vox::Texture2D> mTexture, mYingaTexture;
+    std::shared_ptr<Vox::Texture2D> mYingaTexture;
+    std::unique_ptr<Vox::TextureAtlas> mAtlas;
 
     Vox::OrthographicCamera mCamera;
     glm::vec3 mCameraPosition;
+    glm::vec3 mPreviousCameraPosition{ 0.0f };
     float mCameraMoveSpeed = 5.0f;
     float mCameraRotation = 0.0f;
+    float mPreviousCameraRotation = 0.0f;
     float mCameraRotationSpeed = 180.0f;
 };
 
@@ -8,6 +8,7 @@
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
+#include <vox/vfs/embedded.h>
 
 #include <algorithm>
 #include <array>
@@ -169,6 +170,17 @@ static std::vector<char> readFile(const std::string &filename) {
     return buffer;
 }
 
+VOX_DECLARE_EMBEDDED_FILES(vkdemo);
+
+// Prefers the copy compiled into the executable, falling back to the file next to it
+static std::vector<char> readShader(const std::string &filename) {
+    if (const Vox::EmbeddedFile *file = Vox::FindEmbeddedFile(VoxEmbedded_vkdemo(), filename)) {
+        const auto *data = reinterpret_cast<const char *>(file->data.data());
+        return std::vector<char>(data, data + file->data.size());
+    }
+    return readFile(filename);
+}
+
 class Application {
 public:
     void run() {
@@ -758,8 +770,8 @@ private:
     }
 
     void createGraphicsPipeline() {
-        auto vertShaderCode = readFile("shaders/shader.vert.spv");
-        auto fragShaderCode = readFile("shaders/shader.frag.spv");
+        auto vertShaderCode = readShader("shaders/shader.vert.spv");
+        auto fragShaderCode = readShader("shaders/shader.frag.spv");
 
         VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
         VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
@@ -0,0 +1,66 @@
+// Batched quads for Renderer2D. Embedded into the engine, see vox_embed_resources.
+
+#type vertex
+#version 330 core
+
+layout(location = 0) in vec3 a_position;
+layout(location = 1) in vec4 a_color;
+layout(location = 2) in vec2 a_texCoord;
+layout(location = 3) in float a_texIndex;
+layout(location = 4) in float a_texLayer;
+
+layout(std140) uniform Scene {
+    mat4 u_viewProjection;
+};
+
+out vec4 v_color;
+out vec2 v_texCoord;
+flat out float v_texIndex;
+flat out float v_texLayer;
+
+void main() {
+    v_color = a_color;
+    v_texCoord = a_texCoord;
+    v_texIndex = a_texIndex;
+    v_texLayer = a_texLayer;
+    gl_Position = u_viewProjection * vec4(a_position, 1.0);
+}
+
+#type fragment
+#version 330 core
+
+// GLSL 3.30 only allows sampler arrays to be indexed with constant expressions, so pick the slot with a switch.
+// Slots 12 to 15 hold texture arrays, sampled at the vertex's layer.
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_color;
+in vec2 v_texCoord;
+flat in float v_texIndex;
+flat in float v_texLayer;
+
+uniform sampler2D u_textures[12];
+uniform sampler2DArray u_textureArrays[4];
+
+void main() {
+    vec4 texColor = vec4(1.0);
+    switch (int(v_texIndex)) {
+        case  0: texColor = texture(u_textures[ 0], v_texCoord); break;
+        case  1: texColor = texture(u_textures[ 1], v_texCoord); break;
+        case  2: texColor = texture(u_textures[ 2], v_texCoord); break;
+        case  3: texColor = texture(u_textures[ 3], v_texCoord); break;
+        case  4: texColor = texture(u_textures[ 4], v_texCoord); break;
+        case  5: texColor = texture(u_textures[ 5], v_texCoord); break;
+        case  6: texColor = texture(u_textures[ 6], v_texCoord); break;
+        case  7: texColor = texture(u_textures[ 7], v_texCoord); break;
+        case  8: texColor = texture(u_textures[ 8], v_texCoord); break;
+        case  9: texColor = texture(u_textures[ 9], v_texCoord); break;
+        case 10: texColor = texture(u_textures[10], v_texCoord); break;
+        case 11: texColor = texture(u_textures[11], v_texCoord); break;
+        case 12: texColor = texture(u_textureArrays[0], vec3(v_texCoord, v_texLayer)); break;
+        case 13: texColor = texture(u_textureArrays[1], vec3(v_texCoord, v_texLayer)); break;
+        case 14: texColor = texture(u_textureArrays[2], vec3(v_texCoord, v_texLayer)); break;
+        case 15: texColor = texture(u_textureArrays[3], vec3(v_texCoord, v_texLayer)); break;
+    }
+    color = texColor * v_color;
+}
@@ -0,0 +1,122 @@
+// vox-image-bench: times the image import kernels at every SIMD level the CPU supports against the scalar versions,
+// and checks that each level produces exactly the scalar output.
+//
+//   vox-image-bench [size]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "vox/image/image_ops.h"
+
+using Vox::ImageOps::SimdLevel;
+
+struct Benchmark {
+    const char *name;
+    // Bytes read per run, for throughput
+    size_t bytes;
+    // Resets inputs; not timed
+    std::function<void()> setup;
+    std::function<void()> run;
+    // Output to compare between levels
+    std::function<std::vector<uint8_t>()> result;
+};
+
+// Best of several runs, in seconds
+static double Time(const Benchmark &benchmark) {
+    double best = 1e9;
+    for (int i = 0; i < 10; i++) {
+        benchmark.setup();
+        const auto start = std::chrono::steady_clock::now();
+        benchmark.run();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+template<typename T>
+static std::vector<uint8_t> Bytes(const std::vector<T> &data) {
+    const auto *begin = reinterpret_cast<const uint8_t *>(data.data());
+    return { begin, begin + data.size() * sizeof(T) };
+}
+
+int main(const int argc, char **argv) {
+    const uint32_t size = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 2048;
+    const size_t pixelCount = static_cast<size_t>(size) * size;
+
+    std::mt19937 random(23);
+    std::vector<uint8_t> rgb(pixelCount * 3), rgba(pixelCount * 4);
+    for (auto &value : rgb) value = static_cast<uint8_t>(random());
+    for (auto &value : rgba) value = static_cast<uint8_t>(random());
+
+    std::vector<uint8_t> work(pixelCount * 4), mip(pixelCount);
+    std::vector<float> linear(pixelCount * 4);
+
+    const Benchmark benchmarks[] = {
+        { "flipVertical", pixelCount * 4,
+          [&] { work = rgba; },
+          [&] { Vox::ImageOps::flipVertical(work.data(), static_cast<size_t>(size) * 4, size); },
+          [&] { return work; } },
+        { "expandRGBToRGBA", pixelCount * 3,
+          [] {},
+          [&] { Vox::ImageOps::expandRGBToRGBA(rgb.data(), work.data(), pixelCount); },
+          [&] { return work; } },
+        { "premultiplyAlpha", pixelCount * 4,
+          [&] { work = rgba; },
+          [&] { Vox::ImageOps::premultiplyAlpha(work.data(), pixelCount); },
+          [&] { return work; } },
+        { "sRGBToLinear", pixelCount * 4,
+          [] {},
+          [&] { Vox::ImageOps::sRGBToLinear(rgba.data(), linear.data(), pixelCount); },
+          [&] { return Bytes(linear); } },
+        { "downsample", pixelCount * 4,
+          [] {},
+          [&] { Vox::ImageOps::downsample(rgba.data(), size, size, mip.data(), false); },
+          [&] { return mip; } },
+        { "downsample (sRGB)", pixelCount * 4,
+          [] {},
+          [&] { Vox::ImageOps::downsample(rgba.data(), size, size, mip.data(), true); },
+          [&] { return mip; } },
+    };
+
+    std::vector<SimdLevel> levels = { SimdLevel::Scalar };
+    const SimdLevel supported = Vox::ImageOps::getSupportedSimdLevel();
+    if (supported == SimdLevel::AVX2) {
+        levels.push_back(SimdLevel::SSE2);
+    }
+    if (supported != SimdLevel::Scalar) {
+        levels.push_back(supported);
+    }
+
+    std::printf("%ux%u RGBA8, best of 10\n\n", size, size);
+    std::printf("%-20s %-8s %10s %10s %8s\n", "kernel", "level", "ms", "MB/s", "speedup");
+    bool mismatch = false;
+    for (const auto &benchmark : benchmarks) {
+        double scalarTime = 0.0;
+        std::vector<uint8_t> expected;
+        for (const SimdLevel level : levels) {
+            Vox::ImageOps::setSimdLevel(level);
+            const double time = Time(benchmark);
+            const auto result = benchmark.result();
+            if (level == SimdLevel::Scalar) {
+                scalarTime = time;
+                expected = result;
+            }
+            const bool matches = result == expected;
+            mismatch |= !matches;
+
+            std::printf("%-20s %-8s %10.3f %10.0f %7.2fx%s\n", benchmark.name, Vox::ImageOps::getSimdLevelName(level),
+                        time * 1000.0, benchmark.bytes / time / 1e6, scalarTime / time,
+                        matches ? "" : "  MISMATCH");
+        }
+    }
+    Vox::ImageOps::setSimdLevel(supported);
+    return mismatch ? 1 : 0;
+}
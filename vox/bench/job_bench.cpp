@@ -0,0 +1,188 @@
+// vox-job-bench: measures JobSystem scheduling overhead and scaling. Tiny jobs are compared against a single locked
+// queue, which is what the work-stealing deques replace; the loops are compared against running on one thread.
+//
+//   vox-job-bench [workers]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vox/core/job_system.h"
+
+// Best of several runs, in seconds
+static double Time(const std::function<void()> &run) {
+    double best = 1e9;
+    for (int i = 0; i < 5; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// One mutex and condition variable shared by every worker
+class LockedQueuePool {
+public:
+    explicit LockedQueuePool(const uint32_t threadCount) {
+        for (uint32_t i = 0; i < threadCount; i++) {
+            mThreads.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock lock(mMutex);
+                        mCondition.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+                        if (mTasks.empty()) {
+                            return;
+                        }
+                        task = std::move(mTasks.front());
+                        mTasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~LockedQueuePool() {
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto &thread : mThreads) {
+            thread.join();
+        }
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(mMutex);
+            mTasks.push(std::move(task));
+        }
+        mCondition.notify_one();
+    }
+
+private:
+    std::vector<std::thread> mThreads;
+    std::queue<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping = false;
+};
+
+// A few hundred nanoseconds of arithmetic the compiler cannot drop
+static float Work(const uint32_t seed, const uint32_t iterations) {
+    float value = static_cast<float>(seed);
+    for (uint32_t i = 0; i < iterations; i++) {
+        value = std::sqrt(value * 1.0001f + 1.0f);
+    }
+    return value;
+}
+
+static std::atomic<float> sSink = 0.0f;
+
+static uint64_t Fibonacci(const uint32_t n) {
+    if (n < 2) {
+        return n;
+    }
+    if (n < 16) {
+        return Fibonacci(n - 1) + Fibonacci(n - 2);
+    }
+    uint64_t a = 0;
+    Vox::JobGroup group;
+    group.run([&a, n] { a = Fibonacci(n - 1); });
+    const uint64_t b = Fibonacci(n - 2);
+    group.wait();
+    return a + b;
+}
+
+static void Report(const char *name, const double seconds, const double baseline, const char *baselineName) {
+    std::printf("%-22s %9.2f ms   %-13s %9.2f ms   %5.2fx\n", name, seconds * 1e3, baselineName, baseline * 1e3,
+                baseline / seconds);
+}
+
+int main(const int argc, char **argv) {
+    const uint32_t requested = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 0;
+    Vox::JobSystem::init(requested);
+    const uint32_t workers = Vox::JobSystem::getWorkerCount();
+    std::printf("%u workers + calling thread\n\n", workers);
+
+    // Many tiny independent jobs from one thread: pure queue contention
+    {
+        constexpr uint32_t jobCount = 200000;
+        const double stealing = Time([&] {
+            Vox::JobGroup group;
+            for (uint32_t i = 0; i < jobCount; i++) {
+                group.run([i] { sSink.store(Work(i, 16), std::memory_order_relaxed); });
+            }
+            group.wait();
+        });
+
+        LockedQueuePool pool(std::max(1u, workers));
+        const double locked = Time([&] {
+            std::atomic<uint32_t> remaining = jobCount;
+            for (uint32_t i = 0; i < jobCount; i++) {
+                pool.submit([i, &remaining] {
+                    sSink.store(Work(i, 16), std::memory_order_relaxed);
+                    remaining.fetch_sub(1, std::memory_order_release);
+                });
+            }
+            while (remaining.load(std::memory_order_acquire) > 0) {
+                std::this_thread::yield();
+            }
+        });
+        Report("tiny jobs", stealing, locked, "locked queue");
+    }
+
+    // Every job spawns more: the deques are filled by the workers themselves and balanced by stealing
+    {
+        constexpr uint32_t n = 30;
+        const double stealing = Time([&] { sSink.store(static_cast<float>(Fibonacci(n))); });
+        const double serial = Time([&] {
+            std::function<uint64_t(uint32_t)> fibonacci = [&](const uint32_t k) -> uint64_t {
+                return k < 2 ? k : fibonacci(k - 1) + fibonacci(k - 2);
+            };
+            sSink.store(static_cast<float>(fibonacci(n)));
+        });
+        Report("nested fork-join", stealing, serial, "one thread");
+    }
+
+    // Even and uneven loops; the uneven one only scales if idle threads can take over the expensive end
+    {
+        constexpr uint32_t count = 1 << 20;
+        std::vector<float> output(count);
+        const auto even = [&](const uint32_t begin, const uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                output[i] = Work(i, 32);
+            }
+        };
+        const auto uneven = [&](const uint32_t begin, const uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                output[i] = Work(i, 1 + i / (count / 64));
+            }
+        };
+
+        Report("parallelFor even", Time([&] { Vox::JobSystem::parallelFor(count, even); }),
+               Time([&] { even(0, count); }), "one thread");
+        Report("parallelFor uneven", Time([&] { Vox::JobSystem::parallelFor(count, uneven); }),
+               Time([&] { uneven(0, count); }), "one thread");
+    }
+
+    const auto statistics = Vox::JobSystem::getStatistics();
+    std::printf("\n%llu jobs executed, %llu stolen\n", static_cast<unsigned long long>(statistics.executed),
+                static_cast<unsigned long long>(statistics.stolen));
+
+    Vox::JobSystem::shutdown();
+    return 0;
+}
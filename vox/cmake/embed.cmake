@@ -0,0 +1,47 @@
+# Compiles files into a target as constexpr byte arrays, served by Vox::EmbeddedFiles and the VFS without any file I/O.
+#
+#   vox_embed_resources(<target> NAME <name> BASE_DIR <dir> FILES <file>... [PREFIX <prefix>] [NO_REGISTER])
+#
+# Each file is looked up by PREFIX followed by its path relative to BASE_DIR. The generated source also defines
+# VoxEmbedded_<name>() returning the whole table, declared with VOX_DECLARE_EMBEDDED_FILES(<name>). Unless NO_REGISTER is
+# given, the table registers itself during static initialisation; use NO_REGISTER for static libraries, whose unused
+# objects the linker may drop, and for targets that do not link the engine.
+
+function(vox_embed_resources target)
+    cmake_parse_arguments(EMBED "NO_REGISTER" "NAME;BASE_DIR;PREFIX" "FILES" ${ARGN})
+    if(NOT EMBED_NAME MATCHES "^[A-Za-z_][A-Za-z0-9_]*$")
+        message(FATAL_ERROR "vox_embed_resources: NAME must be a C++ identifier, got '${EMBED_NAME}'")
+    endif()
+    if(NOT EMBED_FILES)
+        message(FATAL_ERROR "vox_embed_resources: no FILES given for '${EMBED_NAME}'")
+    endif()
+    get_filename_component(baseDir ${EMBED_BASE_DIR} ABSOLUTE BASE_DIR ${CMAKE_CURRENT_SOURCE_DIR})
+
+    set(inputs)
+    foreach(file ${EMBED_FILES})
+        list(APPEND inputs ${baseDir}/${file})
+    endforeach()
+    if(EMBED_NO_REGISTER)
+        set(register OFF)
+    else()
+        set(register ON)
+    endif()
+
+    set(generator ${CMAKE_CURRENT_FUNCTION_LIST_DIR}/embed_generate.cmake)
+    # Lists cannot be passed through -D intact, so the file list is joined with '|'
+    string(REPLACE ";" "|" files "${EMBED_FILES}")
+    set(output ${CMAKE_CURRENT_BINARY_DIR}/embedded/${EMBED_NAME}_files.cpp)
+    add_custom_command(OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND}
+            -DNAME=${EMBED_NAME}
+            -DBASE_DIR=${baseDir}
+            -DPREFIX=${EMBED_PREFIX}
+            -DFILES=${files}
+            -DREGISTER=${register}
+            -DOUTPUT=${output}
+            -P ${generator}
+        DEPENDS ${inputs} ${generator}
+        COMMENT "Embedding ${EMBED_NAME} resources"
+        VERBATIM)
+    target_sources(${target} PRIVATE ${output})
+endfunction()
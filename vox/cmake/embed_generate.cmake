@@ -0,0 +1,39 @@
+# Script mode helper for vox_embed_resources; writes OUTPUT from the FILES found under BASE_DIR.
+
+string(REPLACE "|" ";" FILES "${FILES}")
+
+set(arrays "")
+set(entries "")
+set(index 0)
+foreach(file ${FILES})
+    file(READ ${BASE_DIR}/${file} hex HEX)
+    string(LENGTH "${hex}" hexLength)
+    math(EXPR size "${hexLength} / 2")
+
+    # 24 bytes per line
+    set(bytes "")
+    set(offset 0)
+    while(offset LESS hexLength)
+        string(SUBSTRING "${hex}" ${offset} 48 line)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," line "${line}")
+        string(APPEND bytes "${line}\n        ")
+        math(EXPR offset "${offset} + 48")
+    endwhile()
+
+    # The trailing zero lets text be used as a C string; it is not counted in the size
+    string(APPEND arrays "    // ${PREFIX}${file}\n")
+    string(APPEND arrays "    alignas(16) constexpr uint8_t sData${index}[] = {\n        ${bytes}0x00\n    };\n\n")
+    string(APPEND entries "        { \"${PREFIX}${file}\", { sData${index}, ${size} } },\n")
+    math(EXPR index "${index} + 1")
+endforeach()
+
+set(content "// Generated by vox_embed_resources. Do not edit.\n\n")
+string(APPEND content "#include \"vox/vfs/embedded.h\"\n\n")
+string(APPEND content "namespace {\n${arrays}")
+string(APPEND content "    constexpr Vox::EmbeddedFile sFiles[] = {\n${entries}    };\n")
+if(REGISTER)
+    string(APPEND content "\n    [[maybe_unused]] const bool sRegistered = (Vox::EmbeddedFiles::add(sFiles), true);\n")
+endif()
+string(APPEND content "}\n\nVOX_DECLARE_EMBEDDED_FILES(${NAME}) {\n    return sFiles;\n}\n")
+
+file(WRITE ${OUTPUT} "${content}")
@@ -2,19 +2,29 @@
 
 #include "vox/application.h"
 
+#include "vox/core/frame_allocator.h"
+#include "vox/core/job_system.h"
 #include "vox/core/timestep.h"
 
+#include "vox/asset/asset_manager.h"
+#include "vox/vfs/embedded.h"
+#include "vox/vfs/vfs.h"
+
 #include "vox/input.h"
 #include "vox/key_codes.h"
 #include "vox/mouse_button_codes.h"
 
 // ---Renderer ------------------
 #include "vox/renderer/renderer.h"
+#include "vox/renderer/renderer_2d.h"
 #include "vox/renderer/render_command.h"
+#include "vox/renderer/render_thread.h"
 
 #include "vox/renderer/buffer.h"
 #include "vox/renderer/shader.h"
 #include "vox/renderer/texture.h"
+#include "vox/renderer/texture_atlas.h"
+#include "vox/renderer/uniform_buffer.h"
 #include "vox/renderer/vertex_array.h"
 
 #include "vox/renderer/orthographic_camera.h"
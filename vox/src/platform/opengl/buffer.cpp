@@ -1,41 +1,119 @@
 #include "platform/opengl/buffer.h"
 
+#include <cstring>
+#include <stdexcept>
+
 #include <glad/glad.h>
 
+#include "vox/renderer/render_thread.h"
+
+#include "platform/opengl/state_cache.h"
+
 namespace Vox {
-    OpenGLVertexBuffer::OpenGLVertexBuffer(const float *vertices, const uint32_t size) {
+    static GLenum BufferUsageToOpenGLUsage(const BufferUsage usage) {
+        switch (usage) {
+            case BufferUsage::Static: return GL_STATIC_DRAW;
+            case BufferUsage::Dynamic: return GL_DYNAMIC_DRAW;
+            case BufferUsage::Stream: return GL_STREAM_DRAW;
+            default:
+                throw std::runtime_error("Unknown BufferUsage!");
+        }
+    }
+
+    // Updates go through GL_COPY_WRITE_BUFFER so that writing an index buffer never disturbs the element array
+    // binding of whichever vertex array happens to be bound.
+    static void uploadBufferData(const uint32_t buffer, const BufferUsage usage, const uint32_t capacity,
+                                 const void *data, const uint32_t size, const uint32_t offset) {
+        if (offset + size > capacity) {
+            throw std::runtime_error("Buffer write out of range!");
+        }
+        OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+
+        if (usage != BufferUsage::Stream) {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+            return;
+        }
+
+        if (offset == 0) {
+            // Orphan the old store: the driver hands out fresh memory while the GPU finishes with the previous one
+            glBufferData(GL_COPY_WRITE_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+        }
+        // Appends land in a range nothing has read since the orphan, so there is nothing to wait for
+        void *dst = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst) {
+            std::memcpy(dst, data, size);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        } else {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        }
+    }
+
+    OpenGLVertexBuffer::OpenGLVertexBuffer(const uint32_t size, const BufferUsage usage)
+        : mSize(size), mUsage(usage) {
         glGenBuffers(1, &mRendererID);
-        glBindBuffer(GL_ARRAY_BUFFER, mRendererID);
+        OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, mRendererID);
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, BufferUsageToOpenGLUsage(usage));
+    }
+
+    OpenGLVertexBuffer::OpenGLVertexBuffer(const float *vertices, const uint32_t size)
+        : mSize(size), mUsage(BufferUsage::Static) {
+        glGenBuffers(1, &mRendererID);
+        OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, mRendererID);
         glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
     }
 
     OpenGLVertexBuffer::~OpenGLVertexBuffer() {
-        glDeleteBuffers(1, &mRendererID);
+        RenderThread::submit([buffer = mRendererID] {
+            OpenGLStateCache::onBufferDeleted(buffer);
+            glDeleteBuffers(1, &buffer);
+        });
     }
 
     void OpenGLVertexBuffer::bind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, mRendererID);
+        OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, mRendererID);
     }
 
     void OpenGLVertexBuffer::unbind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        OpenGLStateCache::bindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
-    OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32_t *indices, const uint32_t count) : mCount(count) {
+    void OpenGLVertexBuffer::setData(const void *data, const uint32_t size, const uint32_t offset) {
+        uploadBufferData(mRendererID, mUsage, mSize, data, size, offset);
+    }
+
+    OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32_t capacity, const BufferUsage usage, const IndexType type)
+        : mCount(0), mCapacity(capacity), mUsage(usage), mType(type) {
         glGenBuffers(1, &mRendererID);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+        OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, mRendererID);
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity * IndexTypeSize(type), nullptr, BufferUsageToOpenGLUsage(usage));
+    }
+
+    OpenGLIndexBuffer::OpenGLIndexBuffer(const void *indices, const uint32_t count, const IndexType type)
+        : mCount(count), mCapacity(count), mUsage(BufferUsage::Static), mType(type) {
+        glGenBuffers(1, &mRendererID);
+        OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * IndexTypeSize(type), indices, GL_STATIC_DRAW);
     }
 
     OpenGLIndexBuffer::~OpenGLIndexBuffer() {
-        glDeleteBuffers(1, &mRendererID);
+        RenderThread::submit([buffer = mRendererID] {
+            OpenGLStateCache::onBufferDeleted(buffer);
+            glDeleteBuffers(1, &buffer);
+        });
     }
 
     void OpenGLIndexBuffer::bind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
+        OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, mRendererID);
     }
 
     void OpenGLIndexBuffer::unbind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        OpenGLStateCache::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    void OpenGLIndexBuffer::setData(const void *indices, const uint32_t count, const uint32_t offset) {
+        const uint32_t indexSize = IndexTypeSize(mType);
+        uploadBufferData(mRendererID, mUsage, mCapacity * indexSize, indices, count * indexSize, offset * indexSize);
+        mCount = offset + count;
     }
 }
@@ -5,32 +5,44 @@
 namespace Vox {
     class OpenGLVertexBuffer : public VertexBuffer {
     public:
+        OpenGLVertexBuffer(uint32_t size, BufferUsage usage);
         OpenGLVertexBuffer(const float *vertices, uint32_t size);
         ~OpenGLVertexBuffer() override;
 
         void bind() const override;
         void unbind() const override;
 
+        void setData(const void *data, uint32_t size, uint32_t offset) override;
+
         const BufferLayout &getLayout() const override { return mLayout; }
         void setLayout(const BufferLayout &layout) override { mLayout = layout; }
 
     private:
         uint32_t mRendererID;
+        uint32_t mSize;
+        BufferUsage mUsage;
         BufferLayout mLayout;
     };
 
     class OpenGLIndexBuffer : public IndexBuffer {
     public:
-        OpenGLIndexBuffer(const uint32_t *indices, uint32_t count);
+        OpenGLIndexBuffer(uint32_t capacity, BufferUsage usage, IndexType type);
+        OpenGLIndexBuffer(const void *indices, uint32_t count, IndexType type);
         ~OpenGLIndexBuffer() override;
 
         void bind() const override;
         void unbind() const override;
 
+        void setData(const void *indices, uint32_t count, uint32_t offset) override;
+
         uint32_t getCount() const override { return mCount; }
+        IndexType getType() const override { return mType; }
 
     private:
         uint32_t mRendererID;
         uint32_t mCount;
+        uint32_t mCapacity;
+        BufferUsage mUsage;
+        IndexType mType;
     };
 }
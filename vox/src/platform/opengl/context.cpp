@@ -30,4 +30,12 @@ namespace Vox {
         glfwSwapBuffers(mWindowHandle);
     }
 
+    void OpenGLContext::makeCurrent() {
+        glfwMakeContextCurrent(mWindowHandle);
+    }
+
+    void OpenGLContext::releaseCurrent() {
+        glfwMakeContextCurrent(nullptr);
+    }
+
 }
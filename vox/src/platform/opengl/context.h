@@ -11,6 +11,8 @@ namespace Vox {
 
         virtual void init() override;
         virtual void swapBuffers() override;
+        virtual void makeCurrent() override;
+        virtual void releaseCurrent() override;
 
     private:
         GLFWwindow *mWindowHandle;
@@ -0,0 +1,190 @@
+#include "platform/opengl/program_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <glad/glad.h>
+
+namespace Vox {
+    struct ProgramCacheHeader {
+        static constexpr uint32_t Magic = 0x50435856; // "VXCP"
+        static constexpr uint32_t Version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t binaryFormat;
+        uint32_t binarySize;
+        // How long the program took to build from source, for reporting time saved
+        double compileMilliseconds;
+    };
+
+    static std::filesystem::path sDirectory;
+    static std::string sDriver;
+    static std::vector<GLint> sBinaryFormats;
+    static bool sEnabled = false;
+    static bool sReported = false;
+    static OpenGLProgramCache::Statistics sStats;
+
+    // 64-bit FNV-1a
+    static uint64_t Hash(uint64_t hash, const std::string_view data) {
+        for (const char c : data) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    static std::string GetString(const GLenum name) {
+        const auto *value = reinterpret_cast<const char *>(glGetString(name));
+        return value ? value : "";
+    }
+
+    static std::filesystem::path GetEntryPath(const uint64_t key) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return sDirectory / name;
+    }
+
+    // Program binaries are core from 4.1. The glad loader is generated without extensions and only loads the entry
+    // points on a 4.1 or newer context, so on a strict 3.3 context the cache stays off even where the driver offers
+    // ARB_get_program_binary. A driver reporting no formats cannot use them either way.
+    void OpenGLProgramCache::init(const std::string &directory) {
+        sDirectory = directory;
+        sDriver = GetString(GL_VENDOR) + "\n" + GetString(GL_RENDERER) + "\n" + GetString(GL_VERSION);
+
+        GLint formatCount = 0;
+        if (glGetProgramBinary && glProgramBinary && glProgramParameteri) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        }
+        sBinaryFormats.resize(formatCount);
+        if (formatCount > 0) {
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, sBinaryFormats.data());
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(sDirectory, error);
+        sEnabled = formatCount > 0 && !error;
+    }
+
+    void OpenGLProgramCache::endFrame() {
+        if (sReported || !sEnabled) {
+            return;
+        }
+        sReported = true;
+        if (sStats.hits + sStats.misses == 0) {
+            return;
+        }
+        std::cout << "Shader cache: " << sStats.hits << "/" << sStats.hits + sStats.misses
+                  << " programs loaded from cache, saved " << sStats.savedMilliseconds << " ms" << std::endl;
+    }
+
+    bool OpenGLProgramCache::isEnabled() {
+        return sEnabled;
+    }
+
+    uint64_t OpenGLProgramCache::makeKey(const std::vector<std::string_view> &sources) {
+        uint64_t hash = Hash(14695981039346656037ull, sDriver);
+        for (const auto &source : sources) {
+            // Separate the stages so moving text from one to the next changes the key
+            hash = Hash(hash, std::string_view("\0", 1));
+            hash = Hash(hash, source);
+        }
+        return hash;
+    }
+
+    bool OpenGLProgramCache::load(const uint64_t key, const uint32_t program) {
+        if (!sEnabled) {
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto path = GetEntryPath(key);
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        ProgramCacheHeader header{};
+        if (!in || !in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            header.magic != ProgramCacheHeader::Magic || header.version != ProgramCacheHeader::Version) {
+            sStats.misses++;
+            return false;
+        }
+
+        const bool known = std::find(sBinaryFormats.begin(), sBinaryFormats.end(),
+                                     static_cast<GLint>(header.binaryFormat)) != sBinaryFormats.end();
+        // Checked before allocating, so a truncated or corrupt entry is a miss rather than an arbitrary allocation
+        std::error_code sizeError;
+        const uintmax_t fileSize = std::filesystem::file_size(path, sizeError);
+        GLint linked = GL_FALSE;
+        if (known && !sizeError && fileSize - sizeof(header) == header.binarySize) {
+            std::vector<char> binary(header.binarySize);
+            if (in.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+                glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+                glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            }
+        }
+        in.close();
+
+        if (linked == GL_FALSE) {
+            // Corrupt, in a format this driver lacks or rejected by it; rewritten once built from source
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            sStats.misses++;
+            return false;
+        }
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        sStats.hits++;
+        sStats.savedMilliseconds += std::max(0.0, header.compileMilliseconds - elapsed.count());
+        return true;
+    }
+
+    void OpenGLProgramCache::prepare(const uint32_t program) {
+        if (sEnabled) {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    }
+
+    void OpenGLProgramCache::store(const uint64_t key, const uint32_t program, const double compileMilliseconds) {
+        if (!sEnabled) {
+            return;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+        std::vector<char> binary(length);
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &length, &format, binary.data());
+
+        ProgramCacheHeader header{};
+        header.magic = ProgramCacheHeader::Magic;
+        header.version = ProgramCacheHeader::Version;
+        header.binaryFormat = format;
+        header.binarySize = static_cast<uint32_t>(length);
+        header.compileMilliseconds = compileMilliseconds;
+
+        // Written beside the entry and renamed into place, so a crash never leaves a truncated binary behind
+        const auto path = GetEntryPath(key);
+        auto temporaryPath = path;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream out(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(binary.data(), length);
+        }
+        std::error_code error;
+        if (std::filesystem::file_size(temporaryPath, error) != sizeof(header) + static_cast<uint64_t>(length)) {
+            std::filesystem::remove(temporaryPath, error);
+            return;
+        }
+        std::filesystem::rename(temporaryPath, path, error);
+    }
+
+    const OpenGLProgramCache::Statistics &OpenGLProgramCache::getStats() {
+        return sStats;
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vox {
+    // On-disk cache of linked program binaries. Entries are keyed by a hash of the final stage sources together with
+    // the GL vendor, renderer and version strings, so a driver update simply misses instead of loading a stale
+    // binary. A binary the driver rejects anyway is discarded and the program is compiled from source again.
+    class OpenGLProgramCache {
+    public:
+        struct Statistics {
+            uint32_t hits = 0;
+            uint32_t misses = 0;
+            // Compile and link time recorded with each hit, minus the time spent loading its binary
+            double savedMilliseconds = 0.0;
+        };
+
+        static void init(const std::string &directory);
+        // Prints a one line summary of the lookups made during startup, the first time it is called
+        static void endFrame();
+
+        static bool isEnabled();
+        static uint64_t makeKey(const std::vector<std::string_view> &sources);
+
+        // Replaces the program's state with the cached binary. Returns false on a miss or a rejected binary, after
+        // which the program can still be compiled and linked as normal.
+        static bool load(uint64_t key, uint32_t program);
+        // Must be called before linking a program that will be stored
+        static void prepare(uint32_t program);
+        static void store(uint64_t key, uint32_t program, double compileMilliseconds);
+
+        static const Statistics &getStats();
+    };
+}
@@ -1,14 +1,101 @@
 #include "platform/opengl/renderer_api.h"
 
+#include <cstring>
+
 #include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "platform/opengl/program_cache.h"
+#include "platform/opengl/state_cache.h"
+#include "platform/opengl/texture_loader.h"
 
 namespace Vox {
+    static GLenum IndexTypeToOpenGLType(const IndexType type) {
+        switch (type) {
+            case IndexType::UInt8: return GL_UNSIGNED_BYTE;
+            case IndexType::UInt16: return GL_UNSIGNED_SHORT;
+            case IndexType::UInt32: return GL_UNSIGNED_INT;
+            default:
+                throw std::runtime_error("Unknown IndexType!");
+        }
+    }
+
+    std::unique_ptr<OpenGLStreamingBuffer> OpenGLRendererAPI::sStreamingBuffer;
+    bool OpenGLRendererAPI::sParallelShaderCompile = false;
+
+    bool OpenGLRendererAPI::hasExtension(const char *extension) {
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; i++) {
+            if (std::strcmp(reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)), extension) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Lets the driver compile and link on its own threads. Without the extension, compiles may still overlap on
+    // drivers that do it anyway, but there is no way to poll them.
+    static bool EnableParallelShaderCompile() {
+        using MaxShaderCompilerThreadsFn = void (*)(GLuint count);
+        MaxShaderCompilerThreadsFn maxShaderCompilerThreads = nullptr;
+        if (OpenGLRendererAPI::hasExtension("GL_KHR_parallel_shader_compile")) {
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(
+                glfwGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        } else if (OpenGLRendererAPI::hasExtension("GL_ARB_parallel_shader_compile")) {
+            maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFn>(
+                glfwGetProcAddress("glMaxShaderCompilerThreadsARB"));
+        }
+        if (maxShaderCompilerThreads == nullptr) {
+            return false;
+        }
+        // 0xFFFFFFFF leaves the thread count up to the driver
+        maxShaderCompilerThreads(0xFFFFFFFF);
+        return true;
+    }
+
     void OpenGLRendererAPI::init() {
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
         // TODO: remove this line
         glDisable(GL_CULL_FACE);
+
+        // glMultiDrawElementsIndirect is core in 4.3, but shaders need gl_DrawID to find their draw's data, which is
+        // only core from 4.6
+        mCapabilities.multiDrawIndirect = GLAD_GL_VERSION_4_6 && glMultiDrawElementsIndirect != nullptr;
+        if (mCapabilities.multiDrawIndirect) {
+            GLint alignment = 256;
+            glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+            mStorageBufferAlignment = static_cast<uint32_t>(alignment);
+        }
+
+        sParallelShaderCompile = EnableParallelShaderCompile();
+        OpenGLProgramCache::init(ProgramCacheDirectory);
+        sStreamingBuffer = std::make_unique<OpenGLStreamingBuffer>(StreamingRegionSize, FramesInFlight);
+        OpenGLTextureLoader::init();
+    }
+
+    void OpenGLRendererAPI::shutdown() {
+        OpenGLTextureLoader::shutdown();
+        sStreamingBuffer.reset();
+    }
+
+    void OpenGLRendererAPI::beginFrame() {
+        sStreamingBuffer->beginFrame();
+        OpenGLTextureLoader::beginFrame();
+    }
+
+    void OpenGLRendererAPI::endFrame() {
+        OpenGLTextureLoader::endFrame();
+        sStreamingBuffer->endFrame();
+        OpenGLStateCache::endFrame();
+        OpenGLProgramCache::endFrame();
+    }
+
+    RendererAPI::FrameStatistics OpenGLRendererAPI::getFrameStatistics() const {
+        const auto &stats = OpenGLStateCache::getFrameStatistics();
+        return { stats.issued, stats.elided };
     }
 
     void OpenGLRendererAPI::setClearColor(const glm::vec4 &color) {
@@ -19,7 +106,39 @@ namespace Vox {
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
-    void OpenGLRendererAPI::drawIndexed(const std::shared_ptr<VertexArray> &vertexArray) {
-        glDrawElements(GL_TRIANGLES, vertexArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr);
+    void OpenGLRendererAPI::drawIndexed(const VertexArray &vertexArray, const uint32_t indexCount) {
+        const auto &indexBuffer = vertexArray.getIndexBuffer();
+        const uint32_t count = indexCount ? indexCount : indexBuffer->getCount();
+        glDrawElements(GL_TRIANGLES, count, IndexTypeToOpenGLType(indexBuffer->getType()), nullptr);
+    }
+
+    void OpenGLRendererAPI::drawIndexedInstanced(const VertexArray &vertexArray, const uint32_t instanceCount) {
+        const auto &indexBuffer = vertexArray.getIndexBuffer();
+        glDrawElementsInstanced(GL_TRIANGLES, indexBuffer->getCount(), IndexTypeToOpenGLType(indexBuffer->getType()),
+                                nullptr, instanceCount);
+    }
+
+    void OpenGLRendererAPI::multiDrawIndexed(const VertexArray &vertexArray, const DrawIndexedIndirectCommand *commands,
+                                             const glm::mat4 *transforms, const uint32_t drawCount) {
+        if (!mCapabilities.multiDrawIndirect) {
+            throw std::runtime_error("Multi-draw indirect is not supported by this context!");
+        }
+
+        auto &streamingBuffer = *sStreamingBuffer;
+        const auto commandAllocation = streamingBuffer.allocate(drawCount * sizeof(DrawIndexedIndirectCommand));
+        std::memcpy(commandAllocation.data, commands, commandAllocation.size);
+        const auto drawDataAllocation = streamingBuffer.allocate(drawCount * sizeof(glm::mat4),
+                                                                 mStorageBufferAlignment);
+        std::memcpy(drawDataAllocation.data, transforms, drawDataAllocation.size);
+        streamingBuffer.flush();
+
+        OpenGLStateCache::bindBufferRange(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, streamingBuffer.getRendererID(),
+                                          drawDataAllocation.offset, drawDataAllocation.size);
+        OpenGLStateCache::bindBuffer(GL_DRAW_INDIRECT_BUFFER, streamingBuffer.getRendererID());
+
+        const auto &indexBuffer = vertexArray.getIndexBuffer();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, IndexTypeToOpenGLType(indexBuffer->getType()),
+                                    reinterpret_cast<const void *>(static_cast<uintptr_t>(commandAllocation.offset)),
+                                    drawCount, 0);
     }
 }
@@ -1,15 +1,50 @@
 #pragma once
 
+#include <memory>
+
 #include "vox/renderer/renderer_api.h"
 
+#include "platform/opengl/streaming_buffer.h"
+
 namespace Vox {
     class OpenGLRendererAPI : public RendererAPI {
     public:
         void init() override;
+        void shutdown() override;
+
+        void beginFrame() override;
+        void endFrame() override;
+        FrameStatistics getFrameStatistics() const override;
+        const Capabilities &getCapabilities() const override { return mCapabilities; }
 
         void setClearColor(const glm::vec4 &color) override;
         void clear() override;
 
-        void drawIndexed(const std::shared_ptr<VertexArray> &vertexArray) override;
+        void drawIndexed(const VertexArray &vertexArray, uint32_t indexCount) override;
+        void drawIndexedInstanced(const VertexArray &vertexArray, uint32_t instanceCount) override;
+        void multiDrawIndexed(const VertexArray &vertexArray, const DrawIndexedIndirectCommand *commands,
+                              const glm::mat4 *transforms, uint32_t drawCount) override;
+
+        // Per-frame transient vertex, index and uniform data is sub-allocated from here
+        static OpenGLStreamingBuffer &getStreamingBuffer() { return *sStreamingBuffer; }
+
+        // The glad loader is generated without extensions, so look them up by name
+        static bool hasExtension(const char *extension);
+        // True when programs can be polled for completion without blocking (KHR/ARB_parallel_shader_compile)
+        static bool supportsParallelShaderCompile() { return sParallelShaderCompile; }
+
+        static constexpr uint32_t StreamingRegionSize = 2 * 1024 * 1024;
+        static constexpr uint32_t FramesInFlight = 3;
+        // Relative to the working directory, like the assets
+        static constexpr const char *ProgramCacheDirectory = "shader_cache";
+        // Shader storage binding of the DrawData block read by multi-draw shaders
+        static constexpr uint32_t DrawDataBinding = 0;
+
+    private:
+        Capabilities mCapabilities;
+        uint32_t mStorageBufferAlignment = 256;
+
+        static std::unique_ptr<OpenGLStreamingBuffer> sStreamingBuffer;
+        static bool sParallelShaderCompile;
     };
 }
@@ -1,7 +1,7 @@
 #include "platform/opengl/shader.h"
 
-#include <array>
-#include <fstream>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <vector>
 
@@ -9,7 +9,30 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include "vox/renderer/render_command.h"
+#include "vox/renderer/render_thread.h"
+#include "vox/renderer/uniform_buffer.h"
+#include "vox/vfs/vfs.h"
+
+#include "platform/opengl/program_cache.h"
+#include "platform/opengl/renderer_api.h"
+#include "platform/opengl/state_cache.h"
+
+// From KHR_parallel_shader_compile, which the glad loader is generated without
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
 namespace Vox {
+    struct NamedUniformBlock {
+        const char *name;
+        UniformBlockBinding binding;
+    };
+
+    static constexpr NamedUniformBlock sNamedUniformBlocks[] = {
+        { "Scene", UniformBlockBinding::Scene },
+    };
+
+    static constexpr const char *sDrawDataPragma = "#pragma vox draw_data";
+
     static GLenum getShaderTypeFromString(const std::string &type) {
         if (type == "vertex")
             return GL_VERTEX_SHADER;
@@ -18,16 +41,19 @@ namespace Vox {
         throw std::runtime_error("Unknown shader type!");
     }
 
-    OpenGLShader::OpenGLShader(const std::string &filepath) {
-        const std::string source = readFile(filepath);
-        auto shaderSources = preprocess(source);
-        compile(shaderSources);
-
+    OpenGLShader::OpenGLShader(const std::string &filepath, const bool deferred) {
         auto lastSlash = filepath.find_last_of("/\\");
         lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
         auto lastDot = filepath.rfind('.');
         auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
         mName = filepath.substr(lastSlash, count);
+
+        const std::string source = readFile(filepath);
+        auto shaderSources = preprocess(source);
+        compile(shaderSources);
+        if (!deferred && mPending) {
+            finishCompile();
+        }
     }
 
     OpenGLShader::OpenGLShader(const std::string &name, const std::string &vertexSrc,
@@ -36,24 +62,26 @@ namespace Vox {
         sources[GL_VERTEX_SHADER] = vertexSrc;
         sources[GL_FRAGMENT_SHADER] = fragmentSrc;
         compile(sources);
+        if (mPending) {
+            finishCompile();
+        }
     }
 
     OpenGLShader::~OpenGLShader() {
-        glDeleteProgram(mRendererID);
+        // May run on the update thread while the render thread owns the context
+        RenderThread::submit([program = mRendererID, pending = mPending] {
+            if (pending) {
+                for (uint32_t i = 0; i < pending->shaderCount; i++) {
+                    glDeleteShader(pending->shaders[i]);
+                }
+            }
+            OpenGLStateCache::onProgramDeleted(program);
+            glDeleteProgram(program);
+        });
     }
 
     std::string OpenGLShader::readFile(const std::string &filepath) {
-        std::string result;
-        std::ifstream in(filepath, std::ios::in | std::ios::binary);
-        if (!in) {
-            throw std::runtime_error("Could not open file '" + filepath + "'!");
-        }
-        in.seekg(0, std::ios::end);
-        result.resize(in.tellg());
-        in.seekg(0, std::ios::beg);
-        in.read(&result[0], result.size());
-        in.close();
-        return result;
+        return std::string(VFS::read(filepath).getText());
     }
 
     std::unordered_map<GLenum, std::string> OpenGLShader::preprocess(const std::string &source) {
@@ -79,16 +107,70 @@ namespace Vox {
         return shaderSources;
     }
 
+    // Vertex shaders declare their transform with "#pragma vox draw_data" instead of "uniform mat4 u_transform;".
+    // With multi-draw support the pragma becomes a DrawData storage block indexed by gl_DrawID (raising the stage to
+    // #version 460), otherwise it is the plain uniform. Either way the shader body just uses u_transform.
+    bool OpenGLShader::expandDrawData(std::string &source, const bool multiDraw) {
+        const size_t pragma = source.find(sDrawDataPragma);
+        if (pragma == std::string::npos) {
+            return false;
+        }
+        const size_t pragmaEnd = pragma + strlen(sDrawDataPragma);
+
+        if (!multiDraw) {
+            source.replace(pragma, pragmaEnd - pragma, "uniform mat4 u_transform;");
+            return true;
+        }
+
+        source.replace(pragma, pragmaEnd - pragma,
+                       "layout(std430, binding = " + std::to_string(OpenGLRendererAPI::DrawDataBinding) +
+                       ") readonly buffer DrawData {\n"
+                       "    mat4 vx_drawTransforms[];\n"
+                       "};\n"
+                       "#define u_transform vx_drawTransforms[gl_DrawID]");
+
+        const size_t version = source.find("#version");
+        if (version == std::string::npos) {
+            throw std::runtime_error("Shader using draw_data has no #version directive!");
+        }
+        const size_t versionEnd = source.find_first_of("\r\n", version);
+        source.replace(version, versionEnd == std::string::npos ? std::string::npos : versionEnd - version,
+                       "#version 460 core");
+        return true;
+    }
+
+    // Issues every compile and the link without asking for any status, so the driver is free to run them in the
+    // background. finishCompile collects the results.
     void OpenGLShader::compile(const std::unordered_map<GLenum, std::string> &shaderSources) {
         if (shaderSources.size() > 2) {
             throw std::runtime_error("Only 2 shaders are supported for now!");
         }
-        std::array<GLenum, 2> glShaderIDs;
-        int glShaderIDIndex = 0;
+
+        // Expand first; the program cache is keyed by exactly what the driver would compile, in a stable order
+        const bool multiDraw = RenderCommand::getCapabilities().multiDrawIndirect;
+        std::vector<std::pair<GLenum, std::string>> sources(shaderSources.begin(), shaderSources.end());
+        std::sort(sources.begin(), sources.end());
+        std::vector<std::string_view> cacheSources;
+        for (auto &[type, source] : sources) {
+            if (type == GL_VERTEX_SHADER && expandDrawData(source, multiDraw)) {
+                mSupportsMultiDraw = multiDraw;
+            }
+            cacheSources.emplace_back(source);
+        }
 
         mRendererID = glCreateProgram();
+        const uint64_t cacheKey = OpenGLProgramCache::makeKey(cacheSources);
+        if (OpenGLProgramCache::load(cacheKey, mRendererID)) {
+            reflectUniforms();
+            bindUniformBlocks();
+            mReady.store(true, std::memory_order_release);
+            return;
+        }
 
-        for (const auto &[type, source] : shaderSources) {
+        const auto start = std::chrono::steady_clock::now();
+        PendingCompile pending{};
+        pending.cacheKey = cacheKey;
+        for (const auto &[type, source] : sources) {
             const GLuint shader = glCreateShader(type);
 
             const GLchar *sourceCStr = source.c_str();
@@ -96,88 +178,233 @@ namespace Vox {
 
             glCompileShader(shader);
 
-            GLint compiled = 0;
-            glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-            if (compiled == GL_FALSE) {
-                GLint maxLength = 0;
-                glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &maxLength);
+            glAttachShader(mRendererID, shader);
+            pending.shaders[pending.shaderCount++] = shader;
+        }
 
-                // TODO: log this error
-                std::vector<GLchar> infoLog(maxLength);
-                glGetShaderInfoLog(shader, maxLength, &maxLength, &infoLog[0]);
+        OpenGLProgramCache::prepare(mRendererID);
+        glLinkProgram(mRendererID);
 
-                glDeleteShader(shader);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        pending.issueMilliseconds = elapsed.count();
+        mPending = pending;
+        // Without parallel compile support there is no way to ask without waiting, so the first bind may stall
+        mReady.store(!OpenGLRendererAPI::supportsParallelShaderCompile(), std::memory_order_release);
+    }
 
-                throw std::runtime_error("Shader compilation failure!");
+    bool OpenGLShader::isReady() const {
+        if (mReady.load(std::memory_order_acquire)) {
+            return true;
+        }
+        // The status can only be asked for on the thread owning the context; the answer shows up once it has run
+        RenderThread::submit([this] {
+            if (!mPending) {
+                return;
             }
+            GLint complete = GL_FALSE;
+            glGetProgramiv(mRendererID, GL_COMPLETION_STATUS_KHR, &complete);
+            if (complete == GL_TRUE) {
+                mReady.store(true, std::memory_order_release);
+            }
+        });
+        return mReady.load(std::memory_order_acquire);
+    }
 
-            glAttachShader(mRendererID, shader);
-            glShaderIDs[glShaderIDIndex++] = shader;
-        }
+    // Blocks until the driver has finished. A failed link is blamed on whichever stage failed to compile, if any.
+    void OpenGLShader::finishCompile() {
+        const PendingCompile pending = *mPending;
+        mPending.reset();
+        const auto start = std::chrono::steady_clock::now();
 
-        glLinkProgram(mRendererID);
+        const auto deleteAll = [&] {
+            glDeleteProgram(mRendererID);
+            mRendererID = 0;
+            for (uint32_t i = 0; i < pending.shaderCount; i++) {
+                glDeleteShader(pending.shaders[i]);
+            }
+        };
 
         GLint linked = 0;
         glGetProgramiv(mRendererID, GL_LINK_STATUS, &linked);
         if (linked == GL_FALSE) {
+            for (uint32_t i = 0; i < pending.shaderCount; i++) {
+                GLint compiled = 0;
+                glGetShaderiv(pending.shaders[i], GL_COMPILE_STATUS, &compiled);
+                if (compiled == GL_FALSE) {
+                    GLint maxLength = 0;
+                    glGetShaderiv(pending.shaders[i], GL_INFO_LOG_LENGTH, &maxLength);
+
+                    // TODO: log this error
+                    std::vector<GLchar> infoLog(maxLength + 1);
+                    glGetShaderInfoLog(pending.shaders[i], maxLength, &maxLength, &infoLog[0]);
+
+                    deleteAll();
+                    throw std::runtime_error("Shader compilation failure in '" + mName + "'!");
+                }
+            }
+
             GLint maxLength = 0;
             glGetProgramiv(mRendererID, GL_INFO_LOG_LENGTH, &maxLength);
 
             // TODO: log this error
-            std::vector<GLchar> infoLog(maxLength);
+            std::vector<GLchar> infoLog(maxLength + 1);
             glGetProgramInfoLog(mRendererID, maxLength, &maxLength, &infoLog[0]);
 
-            glDeleteProgram(mRendererID);
-            for (const auto id : glShaderIDs)
-                glDeleteShader(id);
+            deleteAll();
+            throw std::runtime_error("Shader link failure in '" + mName + "'!");
+        }
+
+        for (uint32_t i = 0; i < pending.shaderCount; i++) {
+            glDetachShader(mRendererID, pending.shaders[i]);
+            glDeleteShader(pending.shaders[i]);
+        }
+
+        // Only the time spent on this thread counts; a background compile that overlapped other work cost nothing
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        OpenGLProgramCache::store(pending.cacheKey, mRendererID, pending.issueMilliseconds + elapsed.count());
+
+        reflectUniforms();
+        bindUniformBlocks();
+        mReady.store(true, std::memory_order_release);
+    }
+
+    void OpenGLShader::bindUniformBlocks() {
+        for (const auto &block : sNamedUniformBlocks) {
+            const GLuint index = glGetUniformBlockIndex(mRendererID, block.name);
+            if (index != GL_INVALID_INDEX) {
+                glUniformBlockBinding(mRendererID, index, static_cast<GLuint>(block.binding));
+            }
+        }
+    }
 
-            throw std::runtime_error("Shader link failure!");
+    void OpenGLShader::reflectUniforms() {
+        GLint uniformCount = 0, maxNameLength = 0;
+        glGetProgramiv(mRendererID, GL_ACTIVE_UNIFORMS, &uniformCount);
+        glGetProgramiv(mRendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+        mUniformLocations.clear();
+        mUniformLocations.reserve(uniformCount);
+
+        std::vector<GLchar> nameBuffer(maxNameLength + 1);
+        for (GLint i = 0; i < uniformCount; i++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(mRendererID, i, maxNameLength, &length, &size, &type, nameBuffer.data());
+
+            std::string name(nameBuffer.data(), length);
+            const GLint location = glGetUniformLocation(mRendererID, name.c_str());
+            // Members of uniform blocks have no location
+            if (location < 0) {
+                continue;
+            }
+            mUniformLocations.push_back({ UniformId::hash(name), location });
+
+            // Arrays are reported as "name[0]"; make the bare name and every element addressable too
+            if (name.ends_with("[0]")) {
+                const std::string baseName = name.substr(0, name.size() - 3);
+                mUniformLocations.push_back({ UniformId::hash(baseName), location });
+                for (GLint element = 1; element < size; element++) {
+                    const std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                    const GLint elementLocation = glGetUniformLocation(mRendererID, elementName.c_str());
+                    mUniformLocations.push_back({ UniformId::hash(elementName), elementLocation });
+                }
+            }
         }
 
-        for (const auto id : glShaderIDs)
-            glDetachShader(mRendererID, id);
+        std::sort(mUniformLocations.begin(), mUniformLocations.end(),
+                  [](const UniformLocation &a, const UniformLocation &b) { return a.hash < b.hash; });
+        const auto duplicate = std::adjacent_find(mUniformLocations.begin(), mUniformLocations.end(),
+                                                  [](const UniformLocation &a, const UniformLocation &b) {
+                                                      return a.hash == b.hash;
+                                                  });
+        if (duplicate != mUniformLocations.end()) {
+            throw std::runtime_error("Uniform name hash collision in shader '" + mName + "'!");
+        }
+    }
+
+    int OpenGLShader::getUniformLocation(const UniformId id) const {
+        const auto it = std::lower_bound(mUniformLocations.begin(), mUniformLocations.end(), id.getHash(),
+                                         [](const UniformLocation &a, const uint32_t hash) { return a.hash < hash; });
+        if (it == mUniformLocations.end() || it->hash != id.getHash()) {
+            // Unknown or optimised-out uniform; glUniform* silently ignores location -1
+            return -1;
+        }
+        return it->location;
     }
 
     void OpenGLShader::bind() {
-        glUseProgram(mRendererID);
+        if (mPending) {
+            finishCompile();
+        }
+        OpenGLStateCache::useProgram(mRendererID);
     }
 
     void OpenGLShader::unbind() {
-        glUseProgram(0);
+        OpenGLStateCache::useProgram(0);
     }
 
-    void OpenGLShader::setInt(const std::string &name, int value) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniform1i(location, value);
+    void OpenGLShader::setInt(const std::string &name, const int value) {
+        setInt(UniformId(name), value);
     }
 
-    void OpenGLShader::setFloat(const std::string &name, float value) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniform1f(location, value);
+    void OpenGLShader::setIntArray(const std::string &name, const int *values, const uint32_t count) {
+        setIntArray(UniformId(name), values, count);
+    }
+
+    void OpenGLShader::setFloat(const std::string &name, const float value) {
+        setFloat(UniformId(name), value);
     }
 
     void OpenGLShader::setFloat2(const std::string &name, const glm::vec2 &value) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        setFloat2(UniformId(name), value);
     }
 
     void OpenGLShader::setFloat3(const std::string &name, const glm::vec3 &value) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        setFloat3(UniformId(name), value);
     }
 
     void OpenGLShader::setFloat4(const std::string &name, const glm::vec4 &value) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+        setFloat4(UniformId(name), value);
     }
 
     void OpenGLShader::setMat3(const std::string &name, const glm::mat3 &matrix) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniformMatrix3fv(location, 1, GL_FALSE, value_ptr(matrix));
+        setMat3(UniformId(name), matrix);
     }
 
     void OpenGLShader::setMat4(const std::string &name, const glm::mat4 &matrix) {
-        const GLint location = glGetUniformLocation(mRendererID, name.c_str());
-        glUniformMatrix4fv(location, 1, GL_FALSE, value_ptr(matrix));
+        setMat4(UniformId(name), matrix);
+    }
+
+    void OpenGLShader::setInt(const UniformId id, const int value) {
+        glUniform1i(getUniformLocation(id), value);
+    }
+
+    void OpenGLShader::setIntArray(const UniformId id, const int *values, const uint32_t count) {
+        glUniform1iv(getUniformLocation(id), count, values);
+    }
+
+    void OpenGLShader::setFloat(const UniformId id, const float value) {
+        glUniform1f(getUniformLocation(id), value);
+    }
+
+    void OpenGLShader::setFloat2(const UniformId id, const glm::vec2 &value) {
+        glUniform2f(getUniformLocation(id), value.x, value.y);
+    }
+
+    void OpenGLShader::setFloat3(const UniformId id, const glm::vec3 &value) {
+        glUniform3f(getUniformLocation(id), value.x, value.y, value.z);
+    }
+
+    void OpenGLShader::setFloat4(const UniformId id, const glm::vec4 &value) {
+        glUniform4f(getUniformLocation(id), value.x, value.y, value.z, value.w);
+    }
+
+    void OpenGLShader::setMat3(const UniformId id, const glm::mat3 &matrix) {
+        glUniformMatrix3fv(getUniformLocation(id), 1, GL_FALSE, value_ptr(matrix));
+    }
+
+    void OpenGLShader::setMat4(const UniformId id, const glm::mat4 &matrix) {
+        glUniformMatrix4fv(getUniformLocation(id), 1, GL_FALSE, value_ptr(matrix));
     }
 }
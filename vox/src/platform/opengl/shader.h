@@ -1,6 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "vox/renderer/shader.h"
@@ -10,7 +13,8 @@ typedef unsigned int GLenum;
 namespace Vox {
     class OpenGLShader final : public Shader {
     public:
-        explicit OpenGLShader(const std::string &filepath);
+        // A deferred shader issues its compile and link and returns; the result is collected on the first bind
+        explicit OpenGLShader(const std::string &filepath, bool deferred = false);
         OpenGLShader(const std::string &name, const std::string &vertexSrc, const std::string &fragmentSrc);
         ~OpenGLShader() override;
 
@@ -18,8 +22,11 @@ namespace Vox {
         void unbind() override;
 
         const std::string &getName() const override { return mName; }
+        bool supportsMultiDraw() const override { return mSupportsMultiDraw; }
+        bool isReady() const override;
 
         void setInt(const std::string &name, int value) override;
+        void setIntArray(const std::string &name, const int *values, uint32_t count) override;
         void setFloat(const std::string &name, float value) override;
         void setFloat2(const std::string &name, const glm::vec2 &value) override;
         void setFloat3(const std::string &name, const glm::vec3 &value) override;
@@ -27,12 +34,47 @@ namespace Vox {
         void setMat3(const std::string &name, const glm::mat3 &matrix) override;
         void setMat4(const std::string &name, const glm::mat4 &matrix) override;
 
+        void setInt(UniformId id, int value) override;
+        void setIntArray(UniformId id, const int *values, uint32_t count) override;
+        void setFloat(UniformId id, float value) override;
+        void setFloat2(UniformId id, const glm::vec2 &value) override;
+        void setFloat3(UniformId id, const glm::vec3 &value) override;
+        void setFloat4(UniformId id, const glm::vec4 &value) override;
+        void setMat3(UniformId id, const glm::mat3 &matrix) override;
+        void setMat4(UniformId id, const glm::mat4 &matrix) override;
+
     private:
         static std::string readFile(const std::string &filepath);
         static std::unordered_map<GLenum, std::string> preprocess(const std::string &source);
+        static bool expandDrawData(std::string &source, bool multiDraw);
         void compile(const std::unordered_map<GLenum, std::string> &shaderSources);
+        void finishCompile();
+        void reflectUniforms();
+        void bindUniformBlocks();
+
+        int getUniformLocation(UniformId id) const;
+
+        struct UniformLocation {
+            uint32_t hash;
+            int location;
+        };
+
+        // A compile and link that have been issued but whose status has not been queried yet
+        struct PendingCompile {
+            uint32_t shaders[2];
+            uint32_t shaderCount;
+            uint64_t cacheKey;
+            double issueMilliseconds;
+        };
 
         std::string mName;
         uint32_t mRendererID;
+        bool mSupportsMultiDraw = false;
+        // Sorted by hash; filled once after linking
+        std::vector<UniformLocation> mUniformLocations;
+        // Only touched on the thread owning the context
+        std::optional<PendingCompile> mPending;
+        // Set on the thread owning the context once the program has linked, so isReady can be asked from any thread
+        mutable std::atomic<bool> mReady = false;
     };
 }
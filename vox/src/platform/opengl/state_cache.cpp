@@ -0,0 +1,238 @@
+#include "platform/opengl/state_cache.h"
+
+#include <array>
+
+#include <glad/glad.h>
+
+namespace Vox {
+    // Sentinel for "not known", which forces the next bind through
+    static constexpr uint32_t Unknown = 0xffffffff;
+
+    static constexpr uint32_t MaxTextureUnits = 32;
+    static constexpr uint32_t MaxIndexedBindings = 16;
+
+    enum CachedBufferTarget {
+        ArrayBuffer,
+        ElementArrayBuffer,
+        UniformBuffer,
+        PixelUnpackBuffer,
+        DrawIndirectBuffer,
+        ShaderStorageBuffer,
+        CopyReadBuffer,
+        CopyWriteBuffer,
+        CachedBufferTargetCount
+    };
+
+    enum CachedTextureTarget {
+        Texture2D,
+        Texture2DArray,
+        CachedTextureTargetCount
+    };
+
+    struct IndexedBinding {
+        uint32_t buffer = Unknown;
+        intptr_t offset = 0;
+        intptr_t size = 0;
+    };
+
+    struct StateCacheData {
+        uint32_t program = Unknown;
+        uint32_t vertexArray = Unknown;
+        uint32_t activeTextureUnit = Unknown;
+        std::array<uint32_t, CachedBufferTargetCount> buffers;
+        std::array<std::array<uint32_t, CachedTextureTargetCount>, MaxTextureUnits> textures;
+        std::array<IndexedBinding, MaxIndexedBindings> uniformBindings;
+        std::array<IndexedBinding, MaxIndexedBindings> storageBindings;
+
+        OpenGLStateCache::Statistics current;
+        OpenGLStateCache::Statistics lastFrame;
+
+        StateCacheData() {
+            reset();
+        }
+
+        void reset() {
+            program = Unknown;
+            vertexArray = Unknown;
+            activeTextureUnit = Unknown;
+            buffers.fill(Unknown);
+            for (auto &unit : textures) {
+                unit.fill(Unknown);
+            }
+            uniformBindings.fill({});
+            storageBindings.fill({});
+        }
+    };
+
+    static StateCacheData sState;
+
+    static int getBufferTargetIndex(const uint32_t target) {
+        switch (target) {
+            case GL_ARRAY_BUFFER: return ArrayBuffer;
+            case GL_ELEMENT_ARRAY_BUFFER: return ElementArrayBuffer;
+            case GL_UNIFORM_BUFFER: return UniformBuffer;
+            case GL_PIXEL_UNPACK_BUFFER: return PixelUnpackBuffer;
+            case GL_DRAW_INDIRECT_BUFFER: return DrawIndirectBuffer;
+            case GL_SHADER_STORAGE_BUFFER: return ShaderStorageBuffer;
+            case GL_COPY_READ_BUFFER: return CopyReadBuffer;
+            case GL_COPY_WRITE_BUFFER: return CopyWriteBuffer;
+            default: return -1;
+        }
+    }
+
+    static int getTextureTargetIndex(const uint32_t target) {
+        switch (target) {
+            case GL_TEXTURE_2D: return Texture2D;
+            case GL_TEXTURE_2D_ARRAY: return Texture2DArray;
+            default: return -1;
+        }
+    }
+
+    static bool elide(const bool redundant) {
+        if (redundant) {
+            sState.current.elided++;
+        } else {
+            sState.current.issued++;
+        }
+        return redundant;
+    }
+
+    void OpenGLStateCache::useProgram(const uint32_t program) {
+        if (elide(sState.program == program)) {
+            return;
+        }
+        glUseProgram(program);
+        sState.program = program;
+    }
+
+    void OpenGLStateCache::bindVertexArray(const uint32_t vertexArray) {
+        if (elide(sState.vertexArray == vertexArray)) {
+            return;
+        }
+        glBindVertexArray(vertexArray);
+        sState.vertexArray = vertexArray;
+        // The element array binding is part of the vertex array object
+        sState.buffers[ElementArrayBuffer] = Unknown;
+    }
+
+    void OpenGLStateCache::bindBuffer(const uint32_t target, const uint32_t buffer) {
+        const int index = getBufferTargetIndex(target);
+        if (index >= 0 && elide(sState.buffers[index] == buffer)) {
+            return;
+        }
+        glBindBuffer(target, buffer);
+        if (index >= 0) {
+            sState.buffers[index] = buffer;
+        } else {
+            sState.current.issued++;
+        }
+    }
+
+    void OpenGLStateCache::bindBufferRange(const uint32_t target, const uint32_t index, const uint32_t buffer,
+                                           const intptr_t offset, const intptr_t size) {
+        IndexedBinding *binding = nullptr;
+        if (index < MaxIndexedBindings) {
+            if (target == GL_UNIFORM_BUFFER) {
+                binding = &sState.uniformBindings[index];
+            } else if (target == GL_SHADER_STORAGE_BUFFER) {
+                binding = &sState.storageBindings[index];
+            }
+        }
+
+        if (binding && elide(binding->buffer == buffer && binding->offset == offset && binding->size == size)) {
+            return;
+        }
+        glBindBufferRange(target, index, buffer, offset, size);
+        if (binding) {
+            *binding = { buffer, offset, size };
+        } else {
+            sState.current.issued++;
+        }
+
+        // Indexed binds also replace the generic binding point
+        const int targetIndex = getBufferTargetIndex(target);
+        if (targetIndex >= 0) {
+            sState.buffers[targetIndex] = buffer;
+        }
+    }
+
+    void OpenGLStateCache::bindTexture(const uint32_t target, const uint32_t texture) {
+        bindTexture(sState.activeTextureUnit == Unknown ? 0 : sState.activeTextureUnit, target, texture);
+    }
+
+    void OpenGLStateCache::bindTexture(const uint32_t slot, const uint32_t target, const uint32_t texture) {
+        const int index = getTextureTargetIndex(target);
+        const bool cached = index >= 0 && slot < MaxTextureUnits;
+        if (cached && elide(sState.textures[slot][index] == texture)) {
+            return;
+        }
+
+        if (sState.activeTextureUnit != slot) {
+            glActiveTexture(GL_TEXTURE0 + slot);
+            sState.activeTextureUnit = slot;
+            sState.current.issued++;
+        }
+        glBindTexture(target, texture);
+        if (cached) {
+            sState.textures[slot][index] = texture;
+        } else {
+            sState.current.issued++;
+        }
+    }
+
+    // Names are recycled by the driver, so forget anything that referred to a deleted object
+
+    void OpenGLStateCache::onProgramDeleted(const uint32_t program) {
+        if (sState.program == program) {
+            sState.program = Unknown;
+        }
+    }
+
+    void OpenGLStateCache::onVertexArrayDeleted(const uint32_t vertexArray) {
+        if (sState.vertexArray == vertexArray) {
+            sState.vertexArray = Unknown;
+            sState.buffers[ElementArrayBuffer] = Unknown;
+        }
+    }
+
+    void OpenGLStateCache::onBufferDeleted(const uint32_t buffer) {
+        for (auto &bound : sState.buffers) {
+            if (bound == buffer) {
+                bound = Unknown;
+            }
+        }
+        for (auto &binding : sState.uniformBindings) {
+            if (binding.buffer == buffer) {
+                binding = {};
+            }
+        }
+        for (auto &binding : sState.storageBindings) {
+            if (binding.buffer == buffer) {
+                binding = {};
+            }
+        }
+    }
+
+    void OpenGLStateCache::onTextureDeleted(const uint32_t texture) {
+        for (auto &unit : sState.textures) {
+            for (auto &bound : unit) {
+                if (bound == texture) {
+                    bound = Unknown;
+                }
+            }
+        }
+    }
+
+    void OpenGLStateCache::invalidate() {
+        sState.reset();
+    }
+
+    void OpenGLStateCache::endFrame() {
+        sState.lastFrame = sState.current;
+        sState.current = Statistics();
+    }
+
+    const OpenGLStateCache::Statistics &OpenGLStateCache::getFrameStatistics() {
+        return sState.lastFrame;
+    }
+}
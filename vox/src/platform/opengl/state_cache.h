@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Vox {
+    // Shadow copy of the GL binding state. Every bind in the OpenGL backend goes through here so that binding an
+    // object that is already bound costs nothing. Anything that changes bindings behind its back must call
+    // invalidate().
+    class OpenGLStateCache {
+    public:
+        struct Statistics {
+            uint32_t issued = 0;
+            uint32_t elided = 0;
+        };
+
+        static void useProgram(uint32_t program);
+        static void bindVertexArray(uint32_t vertexArray);
+        static void bindBuffer(uint32_t target, uint32_t buffer);
+        static void bindBufferRange(uint32_t target, uint32_t index, uint32_t buffer, intptr_t offset, intptr_t size);
+        // Binds on the currently active texture unit, for uploads and parameter changes
+        static void bindTexture(uint32_t target, uint32_t texture);
+        static void bindTexture(uint32_t slot, uint32_t target, uint32_t texture);
+
+        static void onProgramDeleted(uint32_t program);
+        static void onVertexArrayDeleted(uint32_t vertexArray);
+        static void onBufferDeleted(uint32_t buffer);
+        static void onTextureDeleted(uint32_t texture);
+
+        static void invalidate();
+
+        // Rolls the per-frame counters; getFrameStatistics() reports the last completed frame
+        static void endFrame();
+        static const Statistics &getFrameStatistics();
+    };
+}
@@ -0,0 +1,105 @@
+#include "platform/opengl/streaming_buffer.h"
+
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include "platform/opengl/state_cache.h"
+
+namespace Vox {
+    OpenGLStreamingBuffer::OpenGLStreamingBuffer(const uint32_t regionSize, const uint32_t regionCount)
+        : mRegionSize(regionSize), mRegionCount(regionCount), mFences(regionCount, nullptr) {
+        const GLsizeiptr totalSize = static_cast<GLsizeiptr>(regionSize) * regionCount;
+
+        glGenBuffers(1, &mRendererID);
+        OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, mRendererID);
+
+        mPersistent = GLAD_GL_VERSION_4_4 && glBufferStorage != nullptr;
+        if (mPersistent) {
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+            mMapped = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+            if (!mMapped) {
+                throw std::runtime_error("Failed to map streaming buffer!");
+            }
+        } else {
+            // Without persistent mapping only one region is ever live; orphaning provides the others
+            glBufferData(GL_COPY_WRITE_BUFFER, regionSize, nullptr, GL_STREAM_DRAW);
+            mShadow.resize(regionSize);
+            mRegionCount = 1;
+        }
+    }
+
+    OpenGLStreamingBuffer::~OpenGLStreamingBuffer() {
+        for (const GLsync fence : mFences) {
+            if (fence) {
+                glDeleteSync(fence);
+            }
+        }
+        if (mMapped) {
+            OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, mRendererID);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        }
+        OpenGLStateCache::onBufferDeleted(mRendererID);
+        glDeleteBuffers(1, &mRendererID);
+    }
+
+    void OpenGLStreamingBuffer::beginFrame() {
+        mRegion = (mRegion + 1) % mRegionCount;
+        mHead = mRegion * mRegionSize;
+        mFlushed = mHead;
+
+        if (!mPersistent) {
+            OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, mRendererID);
+            glBufferData(GL_COPY_WRITE_BUFFER, mRegionSize, nullptr, GL_STREAM_DRAW);
+            return;
+        }
+
+        GLsync &fence = mFences[mRegion];
+        if (!fence) {
+            return;
+        }
+        // Poll first so the common case of an already-finished region does not count as a stall
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED) {
+            mStallCount++;
+            do {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        if (result == GL_WAIT_FAILED) {
+            throw std::runtime_error("Failed to wait for streaming buffer fence!");
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void OpenGLStreamingBuffer::endFrame() {
+        flush();
+        if (mPersistent) {
+            mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
+    OpenGLStreamingBuffer::Allocation OpenGLStreamingBuffer::allocate(const uint32_t size, const uint32_t alignment) {
+        const uint32_t offset = (mHead + alignment - 1) / alignment * alignment;
+        const uint32_t regionEnd = (mRegion + 1) * mRegionSize;
+        if (offset + size > regionEnd) {
+            throw std::runtime_error("Streaming buffer region exhausted!");
+        }
+        mHead = offset + size;
+
+        uint8_t *data = mPersistent ? mMapped + offset : mShadow.data() + (offset - mRegion * mRegionSize);
+        return { data, offset, size };
+    }
+
+    void OpenGLStreamingBuffer::flush() {
+        if (mPersistent || mFlushed == mHead) {
+            mFlushed = mHead;
+            return;
+        }
+        OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, mRendererID);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, mFlushed, mHead - mFlushed, mShadow.data() + mFlushed);
+        mFlushed = mHead;
+    }
+}
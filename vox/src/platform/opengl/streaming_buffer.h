@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+typedef struct __GLsync *GLsync;
+
+namespace Vox {
+    // One large GPU buffer that per-frame vertex, index and uniform data is bump-allocated from. It is split into
+    // regionCount regions, one per frame in flight.
+    //
+    // With GL 4.4 the buffer is persistently and coherently mapped, so allocations are written straight into GPU
+    // visible memory; a fence placed at the end of each frame guards the region until the GPU is done with it.
+    // Older contexts (the 3.3 core profile requested by Window::create) write into a CPU shadow copy instead, which
+    // flush() uploads, and the store is orphaned at the start of every frame.
+    class OpenGLStreamingBuffer {
+    public:
+        struct Allocation {
+            void *data;
+            // Offset from the start of the buffer, for glBindBufferRange, attribute pointers or indirect offsets
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        OpenGLStreamingBuffer(uint32_t regionSize, uint32_t regionCount);
+        ~OpenGLStreamingBuffer();
+
+        OpenGLStreamingBuffer(const OpenGLStreamingBuffer &) = delete;
+        OpenGLStreamingBuffer &operator=(const OpenGLStreamingBuffer &) = delete;
+
+        void beginFrame();
+        void endFrame();
+
+        // Throws when the current region is exhausted. The memory is only valid until endFrame().
+        Allocation allocate(uint32_t size, uint32_t alignment = 4);
+        // Makes everything allocated so far visible to the GPU. Must be called before drawing with the data.
+        void flush();
+
+        uint32_t getRendererID() const { return mRendererID; }
+        bool isPersistent() const { return mPersistent; }
+        // Number of frames that had to wait for the GPU to release their region
+        uint32_t getStallCount() const { return mStallCount; }
+
+    private:
+        uint32_t mRendererID = 0;
+        uint32_t mRegionSize;
+        uint32_t mRegionCount;
+        uint32_t mRegion = 0;
+        uint32_t mHead = 0;
+        uint32_t mFlushed = 0;
+        bool mPersistent = false;
+        uint32_t mStallCount = 0;
+
+        uint8_t *mMapped = nullptr;
+        std::vector<uint8_t> mShadow;
+        std::vector<GLsync> mFences;
+    };
+}
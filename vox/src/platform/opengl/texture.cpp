@@ -1,45 +1,352 @@
 #include "platform/opengl/texture.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <glad/glad.h>
-#include <stb/stb_image.h>
+
+#include "vox/image/image_ops.h"
+#include "vox/renderer/render_thread.h"
+#include "vox/renderer/texture_container.h"
+#include "vox/vfs/vfs.h"
+
+#include "platform/opengl/renderer_api.h"
+#include "platform/opengl/state_cache.h"
+#include "platform/opengl/texture_loader.h"
+
+// From EXT_texture_compression_s3tc and EXT_texture_sRGB, which the glad loader is generated without
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
 
 namespace Vox {
-    OpenGLTexture2D::OpenGLTexture2D(const std::string &path) : mPath(path) {
-        int width, height, channels;
-        stbi_set_flip_vertically_on_load(1);
-        stbi_uc *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        if (!data) {
-            throw std::runtime_error("Failed to load image!");
+    static GLenum TextureFilterToOpenGLFilter(const TextureFilter filter, const bool mips) {
+        switch (filter) {
+            case TextureFilter::Nearest: return mips ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST;
+            case TextureFilter::Linear: return mips ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+            default:
+                throw std::runtime_error("Unknown TextureFilter!");
         }
-        mWidth = width;
-        mHeight = height;
+    }
 
-        GLenum internalFormat = 0, dataFormat = 0;
-        if (channels == 4) {
-            internalFormat = GL_RGBA8;
-            dataFormat = GL_RGBA;
-        } else if (channels == 3) {
-            internalFormat = GL_RGB8;
-            dataFormat = GL_RGB;
+    static GLenum TextureWrapToOpenGLWrap(const TextureWrap wrap) {
+        switch (wrap) {
+            case TextureWrap::Repeat: return GL_REPEAT;
+            case TextureWrap::MirroredRepeat: return GL_MIRRORED_REPEAT;
+            case TextureWrap::ClampToEdge: return GL_CLAMP_TO_EDGE;
+            default:
+                throw std::runtime_error("Unknown TextureWrap!");
         }
+    }
 
-        glGenTextures(1, &mRendererID);
-        glBindTexture(GL_TEXTURE_2D, mRendererID);
+    // Anisotropic filtering is core from 4.6 and available almost everywhere else as an extension. Returns 1 when
+    // unsupported.
+    static float GetMaxSupportedAnisotropy() {
+        static float sMaxAnisotropy = 0.0f;
+        if (sMaxAnisotropy > 0.0f) {
+            return sMaxAnisotropy;
+        }
+
+        sMaxAnisotropy = 1.0f;
+        if (GLAD_GL_VERSION_4_6 || OpenGLRendererAPI::hasExtension("GL_EXT_texture_filter_anisotropic") ||
+            OpenGLRendererAPI::hasExtension("GL_ARB_texture_filter_anisotropic")) {
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &sMaxAnisotropy);
+        }
+        return sMaxAnisotropy;
+    }
+
+    // Expects the texture to be bound to target
+    static void ApplySamplerState(const GLenum target, const TextureSpec &spec, const uint32_t mipLevels) {
+        const bool mips = mipLevels > 1;
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, TextureFilterToOpenGLFilter(spec.minFilter, mips));
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, TextureFilterToOpenGLFilter(spec.magFilter, false));
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, TextureWrapToOpenGLWrap(spec.wrap));
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, TextureWrapToOpenGLWrap(spec.wrap));
+        // Without this the texture is incomplete until every level down to 1x1 exists
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(mipLevels - 1));
+
+        const float anisotropy = std::min(spec.maxAnisotropy, GetMaxSupportedAnisotropy());
+        if (anisotropy > 1.0f) {
+            glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
+        }
+    }
+
+    bool OpenGLTexture2D::supportsS3TC(const bool sRGB) {
+        static const bool sS3TC = OpenGLRendererAPI::hasExtension("GL_EXT_texture_compression_s3tc");
+        static const bool sS3TCSRGB = sS3TC && (OpenGLRendererAPI::hasExtension("GL_EXT_texture_sRGB") ||
+                                                OpenGLRendererAPI::hasExtension("GL_EXT_texture_compression_s3tc_srgb"));
+        return sRGB ? sS3TCSRGB : sS3TC;
+    }
+
+    uint32_t OpenGLTexture2D::getCompressedFormat(const TextureContainerFormat format, const bool sRGB) {
+        switch (format) {
+            case TextureContainerFormat::BC1:
+                return sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case TextureContainerFormat::BC3:
+                return sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            default:
+                throw std::runtime_error("Texture container format is not block compressed!");
+        }
+    }
+
+    uint32_t OpenGLTexture2D::calculateMipLevels(const uint32_t width, const uint32_t height, const uint32_t maxLevels) {
+        uint32_t levels = 1;
+        for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+            levels++;
+        }
+        return maxLevels ? std::min(levels, maxLevels) : levels;
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(const uint32_t width, const uint32_t height, const TextureSpec &spec)
+        : mSpec(spec), mWidth(width), mHeight(height) {
+        mInternalFormat = spec.sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        mDataFormat = GL_RGBA;
+
+        createStorage(nullptr);
+    }
+
+    OpenGLTexture2D::OpenGLTexture2D(const std::string &path, const TextureSpec &spec) : mPath(path), mSpec(spec) {
+        const VFSFile file = VFS::read(path);
+        const auto bytes = file.getData();
+        if (TextureContainer::isContainer(bytes)) {
+            loadContainer(TextureContainer::load(bytes, path));
+            return;
+        }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        ImageOps::DecodeOptions options;
+        options.expandRGB = spec.expandRGB;
+        options.premultiplyAlpha = spec.premultiplyAlpha;
+        const auto image = ImageOps::decode(bytes, options);
+        mWidth = image.width;
+        mHeight = image.height;
 
-        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, mWidth, mHeight, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+        if (image.channels == 4) {
+            mInternalFormat = spec.sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+            mDataFormat = GL_RGBA;
+        } else {
+            mInternalFormat = spec.sRGB ? GL_SRGB8 : GL_RGB8;
+            mDataFormat = GL_RGB;
+        }
+
+        createStorage(image.pixels.data());
+    }
 
-        stbi_image_free(data);
+    std::shared_ptr<OpenGLTexture2D> OpenGLTexture2D::createAsync(const std::string &path, const TextureSpec &spec) {
+        TextureSpec placeholderSpec;
+        placeholderSpec.generateMips = false;
+        auto texture = makeShared(new OpenGLTexture2D(1, 1, placeholderSpec));
+        uint32_t placeholderData = 0xffffffff;
+        texture->setData(&placeholderData, sizeof(uint32_t));
+
+        texture->mPath = path;
+        texture->mSpec = spec;
+        texture->mPlaceholderSize = texture->mSize;
+        texture->mReady.store(false, std::memory_order_relaxed);
+        OpenGLTextureLoader::load(texture);
+        return texture;
     }
 
     OpenGLTexture2D::~OpenGLTexture2D() {
+        RenderThread::submit([texture = mRendererID] {
+            OpenGLStateCache::onTextureDeleted(texture);
+            glDeleteTextures(1, &texture);
+        });
+    }
+
+    void OpenGLTexture2D::createStorage(const void *data) {
+        mMipLevels = mSpec.generateMips ? calculateMipLevels(mWidth, mHeight, mSpec.maxMipLevels) : 1;
+
+        glGenTextures(1, &mRendererID);
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, mRendererID);
+        applySamplerState();
+
+        glTexImage2D(GL_TEXTURE_2D, 0, mInternalFormat, mWidth, mHeight, 0, mDataFormat, GL_UNSIGNED_BYTE, nullptr);
+        if (data) {
+            upload(data);
+        } else if (mMipLevels > 1) {
+            // Allocates the remaining levels
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+        publishSize();
+    }
+
+    // Cooked containers carry their own mip chain, so generateMips and expandRGB do not apply. Block compressed
+    // levels are uploaded as is when the device supports S3TC and decoded to RGBA8 otherwise.
+    void OpenGLTexture2D::loadContainer(const TextureContainer &container) {
+        mWidth = container.getWidth();
+        mHeight = container.getHeight();
+        mMipLevels = container.getLevelCount();
+
+        const bool sRGB = mSpec.sRGB || container.isSRGB();
+        mCompressed = TextureContainer::isBlockCompressed(container.getFormat()) && supportsS3TC(sRGB);
+        if (mCompressed) {
+            mInternalFormat = getCompressedFormat(container.getFormat(), sRGB);
+            mDataFormat = 0;
+        } else {
+            mInternalFormat = sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+            mDataFormat = GL_RGBA;
+        }
+
+        glGenTextures(1, &mRendererID);
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, mRendererID);
+        applySamplerState();
+
+        for (uint32_t i = 0; i < mMipLevels; i++) {
+            const auto &level = container.getLevel(i);
+            if (mCompressed) {
+                glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), mInternalFormat, level.width,
+                                       level.height, 0, level.size, container.getLevelData(i));
+            } else {
+                const auto pixels = container.decodeLevel(i);
+                glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), mInternalFormat, level.width, level.height, 0,
+                             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            }
+        }
+        publishSize();
+    }
+
+    void OpenGLTexture2D::adoptStorage(const uint32_t rendererID, const uint32_t width, const uint32_t height,
+                                       const uint32_t mipLevels, const uint32_t internalFormat, const bool compressed) {
+        OpenGLStateCache::onTextureDeleted(mRendererID);
         glDeleteTextures(1, &mRendererID);
+
+        mRendererID = rendererID;
+        mWidth = width;
+        mHeight = height;
+        mMipLevels = mipLevels;
+        mInternalFormat = internalFormat;
+        mDataFormat = compressed ? 0 : GL_RGBA;
+        mCompressed = compressed;
+
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, mRendererID);
+        applySamplerState();
+
+        publishSize();
+        mReady.store(true, std::memory_order_release);
+    }
+
+    void OpenGLTexture2D::publishSize() {
+        mSize = { mWidth, mHeight, calculateMemorySize() };
+    }
+
+    // Expects the texture to be bound and mMipLevels to be set
+    void OpenGLTexture2D::applySamplerState() {
+        ApplySamplerState(GL_TEXTURE_2D, mSpec, mMipLevels);
+    }
+
+    void OpenGLTexture2D::upload(const void *data) {
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, mRendererID);
+
+        // RGB rows are not 4-byte aligned unless the width happens to be a multiple of 4
+        const bool tightRows = mDataFormat == GL_RGB;
+        if (tightRows) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        }
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mWidth, mHeight, mDataFormat, GL_UNSIGNED_BYTE, data);
+        if (tightRows) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        }
+
+        if (mMipLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+    }
+
+    uint64_t OpenGLTexture2D::calculateMemorySize() const {
+        const bool bc1 = mInternalFormat == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ||
+                         mInternalFormat == GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < mMipLevels; i++) {
+            const uint64_t width = std::max(1u, mWidth >> i);
+            const uint64_t height = std::max(1u, mHeight >> i);
+            if (mCompressed) {
+                size += ((width + 3) / 4) * ((height + 3) / 4) * (bc1 ? 8 : 16);
+            } else {
+                // Drivers pad RGB8 to 4 bytes per texel
+                size += width * height * 4;
+            }
+        }
+        return size;
+    }
+
+    void OpenGLTexture2D::setData(void *data, const uint32_t size) {
+        if (mCompressed) {
+            throw std::runtime_error("Cannot replace the data of a compressed texture!");
+        }
+        const uint32_t bpp = mDataFormat == GL_RGBA ? 4 : 3;
+        if (size != mWidth * mHeight * bpp) {
+            throw std::runtime_error("Data must be entire texture!");
+        }
+        upload(data);
     }
 
     void OpenGLTexture2D::bind(const uint32_t slot) const {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, mRendererID);
+        OpenGLStateCache::bindTexture(slot, GL_TEXTURE_2D, mRendererID);
+    }
+
+    OpenGLTexture2DArray::OpenGLTexture2DArray(const uint32_t width, const uint32_t height, const uint32_t layers,
+                                               const TextureSpec &spec)
+        : mSpec(spec), mWidth(width), mHeight(height), mLayers(layers) {
+        if (layers == 0) {
+            throw std::runtime_error("Texture array must have at least one layer!");
+        }
+        mMipLevels = spec.generateMips ? OpenGLTexture2D::calculateMipLevels(width, height, spec.maxMipLevels) : 1;
+        mInternalFormat = spec.sRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+
+        glGenTextures(1, &mRendererID);
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, mRendererID);
+        ApplySamplerState(GL_TEXTURE_2D_ARRAY, mSpec, mMipLevels);
+
+        for (uint32_t i = 0; i < mMipLevels; i++) {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(i), mInternalFormat, std::max(1u, width >> i),
+                         std::max(1u, height >> i), layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    OpenGLTexture2DArray::~OpenGLTexture2DArray() {
+        RenderThread::submit([texture = mRendererID] {
+            OpenGLStateCache::onTextureDeleted(texture);
+            glDeleteTextures(1, &texture);
+        });
+    }
+
+    uint64_t OpenGLTexture2DArray::getMemorySize() const {
+        uint64_t size = 0;
+        for (uint32_t i = 0; i < mMipLevels; i++) {
+            size += static_cast<uint64_t>(std::max(1u, mWidth >> i)) * std::max(1u, mHeight >> i) * 4;
+        }
+        return size * mLayers;
+    }
+
+    void OpenGLTexture2DArray::setData(void *data, const uint32_t size) {
+        if (size != mWidth * mHeight * 4 * mLayers) {
+            throw std::runtime_error("Data must be entire texture!");
+        }
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, mRendererID);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, mWidth, mHeight, mLayers, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        if (mMipLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        }
+    }
+
+    // Regenerating mips rebuilds every layer, so batch layer uploads before drawing where possible
+    void OpenGLTexture2DArray::setLayerData(const uint32_t layer, const void *data, const uint32_t size) {
+        if (layer >= mLayers) {
+            throw std::runtime_error("Texture array layer out of range!");
+        }
+        if (size != mWidth * mHeight * 4) {
+            throw std::runtime_error("Data must be entire layer!");
+        }
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D_ARRAY, mRendererID);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), mWidth, mHeight, 1, GL_RGBA,
+                        GL_UNSIGNED_BYTE, data);
+        if (mMipLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        }
+    }
+
+    void OpenGLTexture2DArray::bind(const uint32_t slot) const {
+        OpenGLStateCache::bindTexture(slot, GL_TEXTURE_2D_ARRAY, mRendererID);
     }
 }
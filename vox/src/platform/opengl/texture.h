@@ -1,23 +1,102 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 
 #include "vox/renderer/texture.h"
+#include "vox/renderer/texture_container.h"
 
 namespace Vox {
     class OpenGLTexture2D final : public Texture2D {
     public:
-        explicit OpenGLTexture2D(const std::string &path);
+        OpenGLTexture2D(uint32_t width, uint32_t height, const TextureSpec &spec);
+        OpenGLTexture2D(const std::string &path, const TextureSpec &spec);
         ~OpenGLTexture2D() override;
 
-        uint32_t getWidth() const override { return mWidth; }
-        uint32_t getHeight() const override { return mHeight; }
+        // See Texture2D::createAsync; the upload is driven by OpenGLTextureLoader
+        static std::shared_ptr<OpenGLTexture2D> createAsync(const std::string &path, const TextureSpec &spec);
+
+        uint32_t getWidth() const override { return getPublishedSize().width; }
+        uint32_t getHeight() const override { return getPublishedSize().height; }
+        const TextureSpec &getSpec() const override { return mSpec; }
+        bool isReady() const override { return mReady.load(std::memory_order_acquire); }
+        uint64_t getMemorySize() const override { return getPublishedSize().memorySize; }
+
+        void setData(void *data, uint32_t size) override;
 
         void bind(uint32_t slot) const override;
 
     private:
+        friend class OpenGLTexture2DArray;
+        friend class OpenGLTextureLoader;
+
+        static bool supportsS3TC(bool sRGB);
+        static uint32_t getCompressedFormat(TextureContainerFormat format, bool sRGB);
+        // maxLevels of 0 means the full chain down to 1x1
+        static uint32_t calculateMipLevels(uint32_t width, uint32_t height, uint32_t maxLevels = 0);
+
+        // Replaces the placeholder with a fully uploaded texture object
+        void adoptStorage(uint32_t rendererID, uint32_t width, uint32_t height, uint32_t mipLevels,
+                          uint32_t internalFormat, bool compressed);
+
+        // What the getters above report, taken once the storage is final
+        struct PublishedSize {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint64_t memorySize = 0;
+        };
+
+        // An async texture reports its placeholder until adoptStorage has published the real size with mReady
+        const PublishedSize &getPublishedSize() const {
+            return mReady.load(std::memory_order_acquire) ? mSize : mPlaceholderSize;
+        }
+        void publishSize();
+        uint64_t calculateMemorySize() const;
+
+        void createStorage(const void *data);
+        void loadContainer(const TextureContainer &container);
+        void applySamplerState();
+        void upload(const void *data);
+
         std::string mPath;
+        TextureSpec mSpec;
         uint32_t mWidth, mHeight;
+        uint32_t mMipLevels = 1;
+        uint32_t mRendererID;
+        uint32_t mInternalFormat, mDataFormat;
+        // Block compressed levels cannot be replaced with setData
+        bool mCompressed = false;
+
+        // The storage fields above belong to the thread owning the context, which adoptStorage runs on while the
+        // getters may be called from the update thread. mSize is only read once mReady is seen, and mPlaceholderSize is
+        // never written after createAsync.
+        PublishedSize mSize;
+        PublishedSize mPlaceholderSize;
+        std::atomic<bool> mReady = true;
+    };
+
+    class OpenGLTexture2DArray final : public Texture2DArray {
+    public:
+        OpenGLTexture2DArray(uint32_t width, uint32_t height, uint32_t layers, const TextureSpec &spec);
+        ~OpenGLTexture2DArray() override;
+
+        uint32_t getWidth() const override { return mWidth; }
+        uint32_t getHeight() const override { return mHeight; }
+        uint32_t getLayerCount() const override { return mLayers; }
+        const TextureSpec &getSpec() const override { return mSpec; }
+        bool isReady() const override { return true; }
+        uint64_t getMemorySize() const override;
+
+        void setData(void *data, uint32_t size) override;
+        void setLayerData(uint32_t layer, const void *data, uint32_t size) override;
+
+        void bind(uint32_t slot) const override;
+
+    private:
+        TextureSpec mSpec;
+        uint32_t mWidth, mHeight, mLayers;
+        uint32_t mMipLevels;
         uint32_t mRendererID;
+        uint32_t mInternalFormat;
     };
 }
@@ -0,0 +1,311 @@
+#include "platform/opengl/texture_loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "vox/core/job_system.h"
+#include "vox/image/image_ops.h"
+#include "vox/renderer/texture_container.h"
+#include "vox/vfs/vfs.h"
+
+#include "platform/opengl/renderer_api.h"
+#include "platform/opengl/state_cache.h"
+#include "platform/opengl/streaming_buffer.h"
+#include "platform/opengl/texture.h"
+
+namespace Vox {
+    struct TextureUpload {
+        std::weak_ptr<OpenGLTexture2D> texture;
+        std::string path;
+        std::unique_ptr<TextureContainer> image;
+        // Set instead of image when decoding failed
+        std::string error;
+
+        bool compressed = false;
+        bool generateMips = false;
+        GLenum internalFormat = 0;
+
+        // Texture object being filled; 0 until the first upload
+        GLuint rendererID = 0;
+        uint32_t level = 0;
+        uint32_t row = 0;
+        GLsync fence = nullptr;
+    };
+
+    // Decodes run on the job system; counted so shutdown can wait for the ones in flight
+    static JobCounter sDecodeJobs;
+    static std::atomic<bool> sCancelDecodes = false;
+    static std::unique_ptr<OpenGLStreamingBuffer> sUploadBuffer;
+
+    // Filled by the decode workers, drained on the main thread
+    static std::mutex sDecodedMutex;
+    static std::vector<std::shared_ptr<TextureUpload>> sDecoded;
+
+    static std::deque<std::shared_ptr<TextureUpload>> sUploading;
+    static std::vector<std::shared_ptr<TextureUpload>> sFencing;
+    static std::atomic<uint32_t> sPendingCount = 0;
+
+    // Runs on a worker thread. Source images are always expanded to RGBA8 so every row is 4-byte aligned, and block
+    // compressed containers are decoded when the device cannot sample them.
+    static std::unique_ptr<TextureContainer> DecodeImage(const std::string &path, const bool sRGB,
+                                                         const bool premultiplyAlpha, const bool s3tc,
+                                                         const bool s3tcSRGB) {
+        const VFSFile file = VFS::read(path);
+        const auto bytes = file.getData();
+        if (TextureContainer::isContainer(bytes)) {
+            auto container = std::make_unique<TextureContainer>(TextureContainer::load(bytes, path));
+            const bool supported = sRGB || container->isSRGB() ? s3tcSRGB : s3tc;
+            if (supported || !TextureContainer::isBlockCompressed(container->getFormat())) {
+                return container;
+            }
+
+            auto decoded = std::make_unique<TextureContainer>(TextureContainerFormat::RGBA8, container->getWidth(),
+                                                              container->getHeight(), container->isSRGB());
+            for (uint32_t i = 0; i < container->getLevelCount(); i++) {
+                const auto &level = container->getLevel(i);
+                const auto pixels = container->decodeLevel(i);
+                decoded->addLevel(level.width, level.height, pixels.data(), static_cast<uint32_t>(pixels.size()));
+            }
+            return decoded;
+        }
+
+        ImageOps::DecodeOptions options;
+        options.premultiplyAlpha = premultiplyAlpha;
+        const auto image = ImageOps::decode(bytes, options);
+        auto container = std::make_unique<TextureContainer>(TextureContainerFormat::RGBA8, image.width, image.height,
+                                                            sRGB);
+        container->addLevel(image.width, image.height, image.pixels.data(),
+                            static_cast<uint32_t>(image.pixels.size()));
+        return container;
+    }
+
+    static void CreateStorage(TextureUpload &upload) {
+        glGenTextures(1, &upload.rendererID);
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, upload.rendererID);
+        if (upload.compressed) {
+            // Compressed levels are defined by their upload
+            return;
+        }
+        OpenGLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        for (uint32_t i = 0; i < upload.image->getLevelCount(); i++) {
+            const auto &level = upload.image->getLevel(i);
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), upload.internalFormat, level.width, level.height, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+    }
+
+    // Uploads the next strip of upload that fits in budget. Returns false when nothing fits until the next frame.
+    static bool UploadNext(TextureUpload &upload, uint32_t &budget) {
+        const auto &level = upload.image->getLevel(upload.level);
+        const uint8_t *levelData = upload.image->getLevelData(upload.level);
+
+        uint32_t offset, size, rows;
+        if (upload.compressed) {
+            offset = 0;
+            size = level.size;
+            rows = level.height;
+        } else {
+            const uint32_t rowSize = level.width * 4;
+            rows = std::min(level.height - upload.row, budget / rowSize);
+            if (rows == 0 && budget == OpenGLTextureLoader::UploadBudget) {
+                rows = 1;
+            }
+            offset = upload.row * rowSize;
+            size = rows * rowSize;
+        }
+        // A fresh frame always makes progress, even on a strip larger than the whole budget
+        if ((size > budget || rows == 0) && budget < OpenGLTextureLoader::UploadBudget) {
+            return false;
+        }
+
+        if (!upload.rendererID) {
+            CreateStorage(upload);
+        }
+        OpenGLStateCache::bindTexture(GL_TEXTURE_2D, upload.rendererID);
+
+        // Anything the ring cannot hold goes straight from client memory
+        const void *source = levelData + offset;
+        if (size <= OpenGLTextureLoader::UploadBudget) {
+            const auto allocation = sUploadBuffer->allocate(size);
+            std::memcpy(allocation.data, source, size);
+            sUploadBuffer->flush();
+            OpenGLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, sUploadBuffer->getRendererID());
+            source = reinterpret_cast<const void *>(static_cast<uintptr_t>(allocation.offset));
+        } else {
+            OpenGLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        const auto levelIndex = static_cast<GLint>(upload.level);
+        if (upload.compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, levelIndex, upload.internalFormat, level.width, level.height, 0,
+                                   size, source);
+        } else {
+            glTexSubImage2D(GL_TEXTURE_2D, levelIndex, 0, upload.row, level.width, rows, GL_RGBA, GL_UNSIGNED_BYTE,
+                            source);
+        }
+        OpenGLStateCache::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        budget -= std::min(size, budget);
+        upload.row += rows;
+        if (upload.row >= level.height) {
+            upload.row = 0;
+            upload.level++;
+        }
+        return true;
+    }
+
+    static void Discard(const TextureUpload &upload) {
+        if (upload.fence) {
+            glDeleteSync(upload.fence);
+        }
+        if (upload.rendererID) {
+            OpenGLStateCache::onTextureDeleted(upload.rendererID);
+            glDeleteTextures(1, &upload.rendererID);
+        }
+        sPendingCount--;
+    }
+
+    void OpenGLTextureLoader::init() {
+        sUploadBuffer = std::make_unique<OpenGLStreamingBuffer>(UploadBudget, OpenGLRendererAPI::FramesInFlight);
+        sCancelDecodes = false;
+    }
+
+    void OpenGLTextureLoader::shutdown() {
+        // Queued decodes are skipped; waiting for the running ones means nothing is added to sDecoded afterwards
+        sCancelDecodes = true;
+        JobSystem::wait(sDecodeJobs);
+
+        for (const auto &upload : sDecoded) {
+            Discard(*upload);
+        }
+        for (const auto &upload : sUploading) {
+            Discard(*upload);
+        }
+        for (const auto &upload : sFencing) {
+            Discard(*upload);
+        }
+        sDecoded.clear();
+        sUploading.clear();
+        sFencing.clear();
+        sUploadBuffer.reset();
+    }
+
+    void OpenGLTextureLoader::beginFrame() {
+        sUploadBuffer->beginFrame();
+
+        // Swap in the textures whose uploads have completed on the GPU
+        std::erase_if(sFencing, [](const std::shared_ptr<TextureUpload> &upload) {
+            const GLenum result = glClientWaitSync(upload->fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+                return false;
+            }
+            glDeleteSync(upload->fence);
+            upload->fence = nullptr;
+
+            if (const auto texture = upload->texture.lock()) {
+                const auto &image = *upload->image;
+                const uint32_t mipLevels = upload->generateMips
+                                               ? OpenGLTexture2D::calculateMipLevels(image.getWidth(), image.getHeight(),
+                                                                                     texture->getSpec().maxMipLevels)
+                                               : image.getLevelCount();
+                texture->adoptStorage(upload->rendererID, image.getWidth(), image.getHeight(), mipLevels,
+                                      upload->internalFormat, upload->compressed);
+                upload->rendererID = 0;
+            }
+            Discard(*upload);
+            return true;
+        });
+
+        {
+            std::lock_guard lock(sDecodedMutex);
+            for (auto &upload : sDecoded) {
+                sUploading.push_back(std::move(upload));
+            }
+            sDecoded.clear();
+        }
+
+        uint32_t budget = UploadBudget;
+        while (!sUploading.empty() && budget > 0) {
+            auto &upload = *sUploading.front();
+            if (upload.texture.expired()) {
+                Discard(upload);
+                sUploading.pop_front();
+                continue;
+            }
+            if (!upload.image) {
+                // The texture keeps its placeholder; one bad file is no reason to stop the frame
+                std::cerr << "Failed to load texture '" << upload.path << "': " << upload.error << std::endl;
+                Discard(upload);
+                sUploading.pop_front();
+                continue;
+            }
+
+            if (!UploadNext(upload, budget)) {
+                break;
+            }
+            if (upload.level < upload.image->getLevelCount()) {
+                continue;
+            }
+
+            if (upload.generateMips) {
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+            upload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            sFencing.push_back(std::move(sUploading.front()));
+            sUploading.pop_front();
+        }
+    }
+
+    void OpenGLTextureLoader::endFrame() {
+        sUploadBuffer->endFrame();
+    }
+
+    void OpenGLTextureLoader::load(const std::shared_ptr<OpenGLTexture2D> &texture) {
+        auto upload = std::make_shared<TextureUpload>();
+        upload->texture = texture;
+        upload->path = texture->mPath;
+
+        // Everything that touches GL is resolved here, on the thread that owns the context
+        const TextureSpec &spec = texture->getSpec();
+        const bool sRGB = spec.sRGB;
+        const bool premultiplyAlpha = spec.premultiplyAlpha;
+        const bool s3tc = OpenGLTexture2D::supportsS3TC(false);
+        const bool s3tcSRGB = OpenGLTexture2D::supportsS3TC(true);
+        sPendingCount++;
+
+        JobSystem::run([result = std::move(upload), sRGB, premultiplyAlpha, s3tc, s3tcSRGB,
+                        generateMips = spec.generateMips]() {
+            if (sCancelDecodes) {
+                return;
+            }
+            try {
+                result->image = DecodeImage(result->path, sRGB, premultiplyAlpha, s3tc, s3tcSRGB);
+                const bool imageSRGB = sRGB || result->image->isSRGB();
+                result->compressed = TextureContainer::isBlockCompressed(result->image->getFormat());
+                result->internalFormat = result->compressed
+                                             ? OpenGLTexture2D::getCompressedFormat(result->image->getFormat(),
+                                                                                    imageSRGB)
+                                             : imageSRGB ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+                // Cooked containers bring their own mip chain
+                result->generateMips = generateMips && result->image->getLevelCount() == 1;
+            } catch (const std::exception &e) {
+                result->image.reset();
+                result->error = e.what();
+            }
+
+            std::lock_guard lock(sDecodedMutex);
+            sDecoded.push_back(result);
+        }, &sDecodeJobs);
+    }
+
+    uint32_t OpenGLTextureLoader::getPendingCount() {
+        return sPendingCount;
+    }
+}
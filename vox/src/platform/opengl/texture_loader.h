@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Vox {
+    class OpenGLTexture2D;
+
+    // Drives Texture2D::createAsync. Images are decoded as jobs (see JobSystem) into TextureContainer levels, then copied
+    // into a fenced upload ring (the PBO) and uploaded at the start of each frame, at most UploadBudget bytes per
+    // frame. Uncompressed levels are split into row strips so large images spread across frames; compressed levels
+    // go up whole. A new texture object is filled behind the placeholder and swapped in once a fence placed after
+    // its last upload has signalled, so drawing never waits on the transfer.
+    class OpenGLTextureLoader {
+    public:
+        static void init();
+        static void shutdown();
+
+        static void beginFrame();
+        static void endFrame();
+
+        static void load(const std::shared_ptr<OpenGLTexture2D> &texture);
+
+        // Textures that are decoding, uploading or waiting on their fence
+        static uint32_t getPendingCount();
+
+        static constexpr uint32_t UploadBudget = 4 * 1024 * 1024;
+    };
+}
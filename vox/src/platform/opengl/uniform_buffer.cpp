@@ -0,0 +1,33 @@
+#include "platform/opengl/uniform_buffer.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <glad/glad.h>
+
+#include "platform/opengl/renderer_api.h"
+#include "platform/opengl/state_cache.h"
+
+namespace Vox {
+    OpenGLUniformBuffer::OpenGLUniformBuffer(const uint32_t size, const uint32_t binding)
+        : mSize(size), mBinding(binding), mShadow(size) {
+        GLint alignment = 256;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        mAlignment = static_cast<uint32_t>(alignment);
+    }
+
+    void OpenGLUniformBuffer::setData(const void *data, const uint32_t size, const uint32_t offset) {
+        if (offset + size > mSize) {
+            throw std::runtime_error("Uniform buffer write out of range!");
+        }
+        std::memcpy(mShadow.data() + offset, data, size);
+
+        auto &streamingBuffer = OpenGLRendererAPI::getStreamingBuffer();
+        const auto allocation = streamingBuffer.allocate(mSize, mAlignment);
+        std::memcpy(allocation.data, mShadow.data(), mSize);
+        streamingBuffer.flush();
+
+        OpenGLStateCache::bindBufferRange(GL_UNIFORM_BUFFER, mBinding, streamingBuffer.getRendererID(),
+                                          allocation.offset, mSize);
+    }
+}
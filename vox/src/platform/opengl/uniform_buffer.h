@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "vox/renderer/uniform_buffer.h"
+
+namespace Vox {
+    // Backed by the renderer's streaming buffer: each setData() allocates the block from the current frame's region
+    // and rebinds the binding point to it.
+    class OpenGLUniformBuffer final : public UniformBuffer {
+    public:
+        OpenGLUniformBuffer(uint32_t size, uint32_t binding);
+
+        void setData(const void *data, uint32_t size, uint32_t offset) override;
+
+        uint32_t getSize() const override { return mSize; }
+        uint32_t getBinding() const override { return mBinding; }
+
+    private:
+        uint32_t mSize;
+        uint32_t mBinding;
+        uint32_t mAlignment;
+        // CPU copy of the block, so partial updates can still publish a complete block
+        std::vector<uint8_t> mShadow;
+    };
+}
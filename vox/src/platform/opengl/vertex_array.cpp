@@ -2,6 +2,10 @@
 
 #include <glad/glad.h>
 
+#include "vox/renderer/render_thread.h"
+
+#include "platform/opengl/state_cache.h"
+
 namespace Vox {
     static GLenum ShaderDataTypeToOpenGLBaseType(ShaderDataType type) {
         switch (type) {
@@ -26,15 +30,18 @@ namespace Vox {
     }
 
     OpenGLVertexArray::~OpenGLVertexArray() {
-        glDeleteVertexArrays(1, &mRendererID);
+        RenderThread::submit([vertexArray = mRendererID] {
+            OpenGLStateCache::onVertexArrayDeleted(vertexArray);
+            glDeleteVertexArrays(1, &vertexArray);
+        });
     }
 
     void OpenGLVertexArray::bind() const {
-        glBindVertexArray(mRendererID);
+        OpenGLStateCache::bindVertexArray(mRendererID);
     }
 
     void OpenGLVertexArray::unbind() const {
-        glBindVertexArray(0);
+        OpenGLStateCache::bindVertexArray(0);
     }
 
     void OpenGLVertexArray::addVertexBuffer(const std::shared_ptr<VertexBuffer>& vertexBuffer) {
@@ -42,26 +49,69 @@ namespace Vox {
             throw std::runtime_error("Vertex Buffer has no layout!");
         }
 
-        glBindVertexArray(mRendererID);
+        OpenGLStateCache::bindVertexArray(mRendererID);
         vertexBuffer->bind();
 
         const auto& layout = vertexBuffer->getLayout();
         for (const auto& element : layout) {
-            glEnableVertexAttribArray(mVertexBufferIndex);
-            glVertexAttribPointer(mVertexBufferIndex,
-                                  element.getComponentCount(),
-                                  ShaderDataTypeToOpenGLBaseType(element.type),
-                                  element.normalized ? GL_TRUE : GL_FALSE,
-                                  layout.getStride(),
-                                  (const void*)(intptr_t)element.offset);
-            mVertexBufferIndex++;
+            switch (element.type) {
+                case ShaderDataType::Float:
+                case ShaderDataType::Float2:
+                case ShaderDataType::Float3:
+                case ShaderDataType::Float4:
+                case ShaderDataType::Bool: {
+                    glEnableVertexAttribArray(mVertexBufferIndex);
+                    glVertexAttribPointer(mVertexBufferIndex,
+                                          element.getComponentCount(),
+                                          ShaderDataTypeToOpenGLBaseType(element.type),
+                                          element.normalized ? GL_TRUE : GL_FALSE,
+                                          layout.getStride(),
+                                          (const void*)(intptr_t)element.offset);
+                    glVertexAttribDivisor(mVertexBufferIndex, element.stepRate);
+                    mVertexBufferIndex++;
+                    break;
+                }
+                case ShaderDataType::Int:
+                case ShaderDataType::Int2:
+                case ShaderDataType::Int3:
+                case ShaderDataType::Int4: {
+                    glEnableVertexAttribArray(mVertexBufferIndex);
+                    glVertexAttribIPointer(mVertexBufferIndex,
+                                           element.getComponentCount(),
+                                           ShaderDataTypeToOpenGLBaseType(element.type),
+                                           layout.getStride(),
+                                           (const void*)(intptr_t)element.offset);
+                    glVertexAttribDivisor(mVertexBufferIndex, element.stepRate);
+                    mVertexBufferIndex++;
+                    break;
+                }
+                case ShaderDataType::Mat3:
+                case ShaderDataType::Mat4: {
+                    // A matrix attribute occupies one location per column; each column is at most a vec4
+                    const uint32_t columns = element.type == ShaderDataType::Mat3 ? 3 : 4;
+                    for (uint32_t i = 0; i < columns; i++) {
+                        glEnableVertexAttribArray(mVertexBufferIndex);
+                        glVertexAttribPointer(mVertexBufferIndex,
+                                              columns,
+                                              GL_FLOAT,
+                                              element.normalized ? GL_TRUE : GL_FALSE,
+                                              layout.getStride(),
+                                              (const void*)(intptr_t)(element.offset + sizeof(float) * columns * i));
+                        glVertexAttribDivisor(mVertexBufferIndex, element.stepRate);
+                        mVertexBufferIndex++;
+                    }
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Unknown ShaderDataType!");
+            }
         }
 
         mVertexBuffers.push_back(vertexBuffer);
     }
 
     void OpenGLVertexArray::setIndexBuffer(const std::shared_ptr<IndexBuffer>& indexBuffer) {
-        glBindVertexArray(mRendererID);
+        OpenGLStateCache::bindVertexArray(mRendererID);
         indexBuffer->bind();
 
         mIndexBuffer = indexBuffer;
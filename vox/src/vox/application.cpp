@@ -2,17 +2,22 @@
 
 #include <memory>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 
+#include "vox/core/frame_allocator.h"
+#include "vox/core/job_system.h"
 #include "vox/input.h"
 #include "vox/renderer/buffer.h"
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 namespace Vox {
     Application *Application::sInstance = nullptr;
 
-    Application::Application(const std::string &name) {
+    Application::Application(const std::string &name, const bool threadedRendering)
+        : mThreadedRendering(threadedRendering) {
         if (sInstance != nullptr) {
             throw std::runtime_error("Application already exists!");
         }
@@ -24,6 +29,12 @@ namespace Vox {
         Renderer::init();
     }
 
+    Application::~Application() {
+        Renderer::shutdown();
+        // Started by its first user; stopped last, as the renderer may still have been waiting on jobs
+        JobSystem::shutdown();
+    }
+
     void Application::onEvent(Event &e) {
         EventDispatcher dispatcher(e);
         dispatcher.dispatch<WindowCloseEvent>(VX_BIND_EVENT_FN(Application::onWindowClose));
@@ -33,23 +44,76 @@ namespace Vox {
         auto startTime = std::chrono::high_resolution_clock::now();
         const auto testDuration = std::chrono::seconds(5); // Run for 5 seconds in test mode
 
+        if (mThreadedRendering) {
+            RenderThread::start(*mWindow);
+        }
+        // When an exception leaves the loop: a joinable std::thread must not be destroyed, and the destructors need
+        // the context back on this thread
+        struct StopRenderThread {
+            ~StopRenderThread() {
+                try {
+                    RenderThread::stop();
+                } catch (...) {
+                }
+            }
+        } stopRenderThread;
+        mLastFrameTime = std::chrono::steady_clock::now();
+
         while (mRunning) {
-            mWindow->onUpdate();
+            // With a render thread, the frame two back has been drawn by now, so its memory can be reused
+            FrameAllocator::beginFrame();
+            mWindow->pollEvents();
 
-            const auto time = static_cast<float>(glfwGetTime());
-            const Timestep timestep = time - mLastFrameTime;
+            // Only the difference is narrowed, so precision does not degrade with uptime
+            const auto time = std::chrono::steady_clock::now();
+            const double frameTime = std::chrono::duration<double>(time - mLastFrameTime).count();
             mLastFrameTime = time;
-            onUpdate(timestep);
+
+            float alpha = 1.0f;
+            if (mFixedTimestep > 0.0) {
+                mFixedAccumulator += frameTime;
+                uint32_t steps = 0;
+                for (; mFixedAccumulator >= mFixedTimestep && steps < mMaxFixedSteps; steps++) {
+                    onFixedUpdate(static_cast<float>(mFixedTimestep));
+                    mFixedAccumulator -= mFixedTimestep;
+                }
+                if (mFixedAccumulator >= mFixedTimestep) {
+                    mFixedAccumulator = std::fmod(mFixedAccumulator, mFixedTimestep);
+                }
+                alpha = static_cast<float>(mFixedAccumulator / mFixedTimestep);
+            }
+
+            Renderer::beginFrame();
+            onUpdate(Timestep(static_cast<float>(frameTime), alpha));
+            Renderer::endFrame();
+
+            if (mThreadedRendering) {
+                RenderThread::endFrame();
+            } else {
+                mWindow->swapBuffers();
+            }
 
             // Auto-close after testDuration if TEST_MODE environment variable is set
             if (std::getenv("TEST_MODE")) {
                 auto currentTime = std::chrono::high_resolution_clock::now();
                 if (currentTime - startTime >= testDuration) {
                     std::cout << "Test mode: auto-closing after " << testDuration.count() << " seconds" << std::endl;
+                    const auto arena = FrameAllocator::getStatistics();
+                    std::cout << "Frame allocator: peak " << arena.peakFrameBytes / 1024 << " KiB per frame, "
+                              << arena.reservedBytes / 1024 << " KiB reserved" << std::endl;
                     mRunning = false;
                 }
             }
         }
+
+        // Resources are destroyed by the destructors with the context back on this thread
+        RenderThread::stop();
+    }
+
+    void Application::setFixedTimestep(const double seconds, const uint32_t maxStepsPerFrame) {
+        mFixedTimestep = seconds;
+        mMaxFixedSteps = maxStepsPerFrame;
+        mFixedAccumulator = 0.0;
     }
 
     bool Application::onWindowClose(WindowCloseEvent &e) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 #include "vox/core/timestep.h"
@@ -10,17 +12,28 @@
 namespace Vox {
     class Application {
     public:
-        explicit Application(const std::string &name);
-        virtual ~Application() = default;
+        // With threadedRendering, the graphics context moves to a render thread for the duration of run and the next
+        // frame is updated while the previous one is submitted; see RenderThread
+        explicit Application(const std::string &name, bool threadedRendering = false);
+        virtual ~Application();
 
         virtual void run();
 
+        // Called once per frame. With a fixed timestep, ts.getAlpha() says how far to interpolate between the states
+        // of the last two fixed updates.
         virtual void onUpdate(const Timestep ts) {}
+        // Called every fixed timestep before onUpdate, zero or more times per frame
+        virtual void onFixedUpdate(const Timestep ts) {}
 
         void onEvent(Event &);
 
         Window &getWindow() const { return *mWindow; }
 
+        // Runs onFixedUpdate at a fixed rate, independent of the frame rate; 0 turns it off. After a long frame at most
+        // maxStepsPerFrame steps are run and the rest of the backlog is dropped, so a slow simulation cannot fall
+        // further behind every frame.
+        void setFixedTimestep(double seconds, uint32_t maxStepsPerFrame = 8);
+
         static Application &get() { return *sInstance; }
 
     private:
@@ -28,7 +41,12 @@ namespace Vox {
 
         std::unique_ptr<Window> mWindow;
         bool mRunning = true;
-        float mLastFrameTime = 0.0f;
+        bool mThreadedRendering;
+        std::chrono::steady_clock::time_point mLastFrameTime;
+
+        double mFixedTimestep = 0.0;
+        uint32_t mMaxFixedSteps = 8;
+        double mFixedAccumulator = 0.0;
 
         static Application *sInstance;
     };
@@ -0,0 +1,135 @@
+#include "vox/asset/asset_manager.h"
+
+#include <filesystem>
+
+namespace Vox {
+    AssetManager::AssetManager() = default;
+
+    AssetManager::AssetManager(const Budget &budget) : mBudget(budget) {
+    }
+
+    AssetHandle<Texture2D> AssetManager::loadTexture(const std::string &path, const TextureSpec &spec,
+                                                     const bool async) {
+        const std::string normalisedPath = normalisePath(path);
+        std::string key = makeTextureKey(normalisedPath, spec, async);
+        if (const Entry *entry = find(key)) {
+            return std::get<std::shared_ptr<Texture2D>>(entry->asset);
+        }
+
+        auto texture = async ? Texture2D::createAsync(normalisedPath, spec) : Texture2D::create(normalisedPath, spec);
+        insert(std::move(key), texture);
+        return texture;
+    }
+
+    AssetHandle<Shader> AssetManager::loadShader(const std::string &path) {
+        const std::string normalisedPath = normalisePath(path);
+        std::string key = "shader:" + normalisedPath;
+        if (const Entry *entry = find(key)) {
+            return std::get<std::shared_ptr<Shader>>(entry->asset);
+        }
+
+        auto shader = Shader::create(normalisedPath);
+        insert(std::move(key), shader);
+        return shader;
+    }
+
+    void AssetManager::setBudget(const Budget &budget) {
+        mBudget = budget;
+        collect();
+    }
+
+    void AssetManager::collect() {
+        evict(false);
+    }
+
+    void AssetManager::clear() {
+        evict(true);
+    }
+
+    void AssetManager::resetCounters() {
+        mStats.hits = 0;
+        mStats.misses = 0;
+        mStats.evictions = 0;
+    }
+
+    std::string AssetManager::normalisePath(const std::string &path) {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    // The same image imported with different settings is a different asset
+    std::string AssetManager::makeTextureKey(const std::string &path, const TextureSpec &spec, const bool async) {
+        std::string key = "texture:" + path + "?";
+        key += std::to_string(static_cast<int>(spec.minFilter)) + "," + std::to_string(static_cast<int>(spec.magFilter));
+        key += "," + std::to_string(static_cast<int>(spec.wrap));
+        key += spec.generateMips ? ",mips" + std::to_string(spec.maxMipLevels) : ",nomips";
+        key += "," + std::to_string(spec.maxAnisotropy);
+        key += spec.sRGB ? ",srgb" : ",linear";
+        key += spec.premultiplyAlpha ? ",premultiplied" : "";
+        key += spec.expandRGB ? ",rgba" : ",rgb";
+        // An async handle may still be a placeholder, which a synchronous caller must not be handed
+        key += async ? ",async" : "";
+        return key;
+    }
+
+    // Textures and shaders keep no CPU side copy once uploaded
+    uint64_t AssetManager::getCpuSize(const Asset &) {
+        return 0;
+    }
+
+    uint64_t AssetManager::getGpuSize(const Asset &asset) {
+        if (const auto *texture = std::get_if<std::shared_ptr<Texture2D>>(&asset)) {
+            return (*texture)->getMemorySize();
+        }
+        // Program binaries are driver owned and not queryable on every context; they are small next to textures
+        return 0;
+    }
+
+    bool AssetManager::isReferenced(const Asset &asset) {
+        return std::visit([](const auto &pointer) { return pointer.use_count() > 1; }, asset);
+    }
+
+    AssetManager::Entry *AssetManager::find(const std::string &key) {
+        const auto it = mLookup.find(key);
+        if (it == mLookup.end()) {
+            mStats.misses++;
+            return nullptr;
+        }
+        mStats.hits++;
+        mEntries.splice(mEntries.begin(), mEntries, it->second);
+        return &*it->second;
+    }
+
+    void AssetManager::insert(std::string key, Asset asset) {
+        mEntries.push_front({ key, std::move(asset) });
+        mLookup.emplace(std::move(key), mEntries.begin());
+        collect();
+    }
+
+    void AssetManager::evict(const bool all) {
+        uint64_t cpuBytes = 0, gpuBytes = 0;
+        for (const auto &entry : mEntries) {
+            cpuBytes += getCpuSize(entry.asset);
+            gpuBytes += getGpuSize(entry.asset);
+        }
+
+        // Walk from the least recently used end, skipping anything still referenced
+        for (auto it = mEntries.end(); it != mEntries.begin();) {
+            --it;
+            if (!all && cpuBytes <= mBudget.cpuBytes && gpuBytes <= mBudget.gpuBytes) {
+                break;
+            }
+            if (isReferenced(it->asset)) {
+                continue;
+            }
+            cpuBytes -= getCpuSize(it->asset);
+            gpuBytes -= getGpuSize(it->asset);
+            mLookup.erase(it->key);
+            it = mEntries.erase(it);
+            mStats.evictions++;
+        }
+
+        mStats.cpuBytes = cpuBytes;
+        mStats.gpuBytes = gpuBytes;
+        mStats.assetCount = static_cast<uint32_t>(mEntries.size());
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <variant>
+
+#include "vox/renderer/shader.h"
+#include "vox/renderer/texture.h"
+
+namespace Vox {
+    // Handles are shared references. An asset counts as unreferenced once the manager holds the only one, which is
+    // what makes it a candidate for eviction.
+    template<typename T>
+    using AssetHandle = std::shared_ptr<T>;
+
+    // Deduplicating cache for file backed assets. Assets are keyed by their normalised path plus the settings they
+    // were imported with, so loading the same file twice returns the same handle. Memory use is tracked per asset
+    // and, whenever a budget is exceeded, unreferenced assets are evicted least recently used first.
+    class AssetManager {
+    public:
+        struct Budget {
+            uint64_t cpuBytes = UINT64_MAX;
+            uint64_t gpuBytes = 512ull * 1024 * 1024;
+        };
+
+        struct Statistics {
+            uint32_t hits = 0;
+            uint32_t misses = 0;
+            uint32_t evictions = 0;
+            uint64_t cpuBytes = 0;
+            uint64_t gpuBytes = 0;
+            uint32_t assetCount = 0;
+        };
+
+        AssetManager();
+        explicit AssetManager(const Budget &budget);
+
+        AssetHandle<Texture2D> loadTexture(const std::string &path, const TextureSpec &spec = {}, bool async = false);
+        AssetHandle<Shader> loadShader(const std::string &path);
+
+        void setBudget(const Budget &budget);
+        const Budget &getBudget() const { return mBudget; }
+
+        // Evicts unreferenced assets until usage is within budget. Runs after every load; call it once per frame as
+        // well if asynchronous textures are in flight, since their size is only known once they are ready.
+        void collect();
+        // Evicts every unreferenced asset
+        void clear();
+
+        // Byte counts are refreshed by collect()
+        const Statistics &getStats() const { return mStats; }
+        void resetCounters();
+
+    private:
+        using Asset = std::variant<std::shared_ptr<Texture2D>, std::shared_ptr<Shader>>;
+
+        struct Entry {
+            std::string key;
+            Asset asset;
+        };
+
+        static std::string normalisePath(const std::string &path);
+        static std::string makeTextureKey(const std::string &path, const TextureSpec &spec, bool async);
+        static uint64_t getCpuSize(const Asset &asset);
+        static uint64_t getGpuSize(const Asset &asset);
+        static bool isReferenced(const Asset &asset);
+
+        // Moves the entry to the front of the LRU list and returns it, or nullptr on a miss
+        Entry *find(const std::string &key);
+        void insert(std::string key, Asset asset);
+        void evict(bool all);
+
+        Budget mBudget;
+        Statistics mStats;
+        // Most recently used first
+        std::list<Entry> mEntries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> mLookup;
+    };
+}
@@ -0,0 +1,122 @@
+#include "vox/core/frame_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Vox {
+    namespace {
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size = 0;
+            // Written only by the thread bumping through the block
+            std::atomic<size_t> used = 0;
+        };
+
+        // The block a thread is bumping through, valid while frame is current
+        struct ThreadArena {
+            uint64_t frame = UINT64_MAX;
+            Block *block = nullptr;
+        };
+    }
+
+    static std::atomic<uint64_t> sFrame = 0;
+    static thread_local ThreadArena tArena;
+
+    static std::mutex sMutex;
+    static std::array<std::vector<Block *>, FrameAllocator::FrameCount> sFrameBlocks;
+    static std::vector<Block *> sFreeBlocks;
+    static size_t sReservedBytes = 0;
+    static size_t sLastFrameBytes = 0;
+    static size_t sPeakFrameBytes = 0;
+
+    // Owns every block; released at exit
+    static std::vector<std::unique_ptr<Block>> sBlocks;
+
+    static void *Bump(Block &block, const size_t size, const size_t alignment) {
+        const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+        const size_t used = block.used.load(std::memory_order_relaxed);
+        const size_t offset = ((base + used + alignment - 1) & ~(alignment - 1)) - base;
+        if (offset + size > block.size) {
+            return nullptr;
+        }
+        block.used.store(offset + size, std::memory_order_relaxed);
+        return block.data.get() + offset;
+    }
+
+    // Takes a block for the given frame; sMutex must be held
+    static Block *AcquireBlock(const uint64_t frame, const size_t size) {
+        Block *block = nullptr;
+        if (size <= FrameAllocator::BlockSize && !sFreeBlocks.empty()) {
+            block = sFreeBlocks.back();
+            sFreeBlocks.pop_back();
+        } else {
+            auto owned = std::make_unique<Block>();
+            owned->size = std::max(size, FrameAllocator::BlockSize);
+            owned->data = std::make_unique<std::byte[]>(owned->size);
+            sReservedBytes += owned->size;
+            block = owned.get();
+            sBlocks.push_back(std::move(owned));
+        }
+        sFrameBlocks[frame % FrameAllocator::FrameCount].push_back(block);
+        return block;
+    }
+
+    void FrameAllocator::beginFrame() {
+        std::lock_guard lock(sMutex);
+        const uint64_t previous = sFrame.load(std::memory_order_relaxed);
+        const uint64_t frame = previous + 1;
+
+        size_t used = 0;
+        for (const Block *block : sFrameBlocks[previous % FrameCount]) {
+            used += block->used.load(std::memory_order_relaxed);
+        }
+        sLastFrameBytes = used;
+        sPeakFrameBytes = std::max(sPeakFrameBytes, used);
+
+        // The frame this one reuses the slot of is FrameCount frames old
+        auto &blocks = sFrameBlocks[frame % FrameCount];
+        for (Block *block : blocks) {
+            block->used.store(0, std::memory_order_relaxed);
+            if (block->size == BlockSize) {
+                sFreeBlocks.push_back(block);
+                continue;
+            }
+            sReservedBytes -= block->size;
+            std::erase_if(sBlocks, [block](const std::unique_ptr<Block> &owned) { return owned.get() == block; });
+        }
+        blocks.clear();
+
+        sFrame.store(frame, std::memory_order_release);
+    }
+
+    uint64_t FrameAllocator::getFrameIndex() {
+        return sFrame.load(std::memory_order_acquire);
+    }
+
+    void *FrameAllocator::allocate(const size_t size, const size_t alignment) {
+        const uint64_t frame = sFrame.load(std::memory_order_acquire);
+        ThreadArena &arena = tArena;
+        if (arena.frame == frame) {
+            if (void *memory = Bump(*arena.block, size, alignment)) {
+                return memory;
+            }
+        }
+
+        std::lock_guard lock(sMutex);
+        const size_t required = size + alignment;
+        if (required > BlockSize) {
+            // Oversized requests do not displace the thread's block
+            return Bump(*AcquireBlock(frame, required), size, alignment);
+        }
+        arena = { frame, AcquireBlock(frame, BlockSize) };
+        return Bump(*arena.block, size, alignment);
+    }
+
+    FrameAllocator::Statistics FrameAllocator::getStatistics() {
+        std::lock_guard lock(sMutex);
+        return { sLastFrameBytes, sPeakFrameBytes, sReservedBytes };
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Vox {
+    // Bump allocator for data that lives for one frame. Memory comes in blocks that are kept between frames; every
+    // thread bumps through a block of its own, so allocating takes no lock or atomic read-modify-write, and job
+    // workers can allocate alongside the update thread. Nothing is freed individually: beginFrame recycles the
+    // blocks of the frame FrameCount frames back in one go.
+    //
+    // Memory allocated during frame f stays valid until beginFrame starts frame f + FrameCount, which leaves the
+    // render thread a frame to consume what the update thread recorded. Destructors are not run for the caller.
+    // Allocating must not overlap beginFrame, so jobs that allocate are waited for within their frame.
+    class FrameAllocator {
+    public:
+        struct Statistics {
+            // Bytes handed out during the last completed frame, alignment padding included
+            size_t lastFrameBytes = 0;
+            // Most any frame has used so far
+            size_t peakFrameBytes = 0;
+            // Bytes held in blocks, in use or not
+            size_t reservedBytes = 0;
+        };
+
+        // Starts the next frame. Called by Application at the top of every frame.
+        static void beginFrame();
+        static uint64_t getFrameIndex();
+
+        static void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template<typename T>
+        static T *allocateArray(const size_t count) {
+            return static_cast<T *>(allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        static Statistics getStatistics();
+
+        static constexpr uint32_t FrameCount = 2;
+        // Larger requests get a block of their own, released when their frame is recycled
+        static constexpr size_t BlockSize = 256 * 1024;
+    };
+
+    // Lets standard containers allocate from the FrameAllocator. Deallocation is a no-op, so containers should be
+    // reserved up front where their size is known; growth leaves the old storage unused until the frame is recycled.
+    template<typename T>
+    class FrameStlAllocator {
+    public:
+        using value_type = T;
+
+        FrameStlAllocator() noexcept = default;
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U> &) noexcept {}
+
+        T *allocate(const size_t count) { return FrameAllocator::allocateArray<T>(count); }
+        void deallocate(T *, size_t) noexcept {}
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U> &) const noexcept { return true; }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    using FrameUnorderedMap = std::unordered_map<Key, Value, Hash, std::equal_to<Key>,
+                                                 FrameStlAllocator<std::pair<const Key, Value>>>;
+}
@@ -0,0 +1,419 @@
+#include "vox/core/job_system.h"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Vox {
+    struct Job {
+        std::function<void()> function;
+        JobCounter *counter;
+        uint32_t queueIndex;
+
+        void run() {
+            try {
+                function();
+            } catch (...) {
+                if (!counter) {
+                    // Nothing could ever see the error, so it is as fatal as one escaping a std::thread
+                    std::terminate();
+                }
+                std::lock_guard lock(counter->mErrorMutex);
+                if (!counter->mError) {
+                    counter->mError = std::current_exception();
+                }
+            }
+            if (counter) {
+                // Last touch; the waiter may destroy the counter as soon as this lands
+                counter->mPending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    };
+
+    // Chase-Lev deque with a fixed ring. Only the owning thread calls push and pop; any thread may steal. The owner's
+    // bottom store and the thieves' top load must be ordered against each other, hence the sequentially consistent
+    // operations rather than standalone fences.
+    class WorkStealingDeque {
+    public:
+        bool push(Job *job) {
+            const int64_t bottom = mBottom.load(std::memory_order_relaxed);
+            const int64_t top = mTop.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<int64_t>(JobSystem::QueueCapacity)) {
+                return false;
+            }
+            mJobs[bottom & Mask].store(job, std::memory_order_relaxed);
+            mBottom.store(bottom + 1, std::memory_order_seq_cst);
+            return true;
+        }
+
+        Job *pop() {
+            const int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+            mBottom.store(bottom, std::memory_order_seq_cst);
+            int64_t top = mTop.load(std::memory_order_seq_cst);
+            if (top > bottom) {
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job *job = mJobs[bottom & Mask].load(std::memory_order_relaxed);
+            if (top == bottom) {
+                // Last job; race the thieves for it
+                if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    job = nullptr;
+                }
+                mBottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job *steal() {
+            int64_t top = mTop.load(std::memory_order_seq_cst);
+            const int64_t bottom = mBottom.load(std::memory_order_seq_cst);
+            if (top >= bottom) {
+                return nullptr;
+            }
+            Job *job = mJobs[top & Mask].load(std::memory_order_relaxed);
+            if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return job;
+        }
+
+    private:
+        static constexpr int64_t Mask = JobSystem::QueueCapacity - 1;
+        static_assert((JobSystem::QueueCapacity & (JobSystem::QueueCapacity - 1)) == 0);
+
+        // Kept on separate cache lines; the owner hammers bottom, thieves top
+        alignas(64) std::atomic<int64_t> mTop = 0;
+        alignas(64) std::atomic<int64_t> mBottom = 0;
+        std::array<std::atomic<Job *>, JobSystem::QueueCapacity> mJobs{};
+    };
+
+    struct alignas(64) WorkQueue {
+        WorkStealingDeque deque;
+        std::atomic<uint64_t> executed = 0;
+        std::atomic<uint64_t> stolen = 0;
+    };
+
+    static constexpr uint32_t NoQueue = ~0u;
+
+    static std::mutex sLifetimeMutex;
+    static std::atomic<bool> sRunning = false;
+    // Bumped on every init so threads re-register their queue after a restart
+    static std::atomic<uint32_t> sGeneration = 0;
+    static uint32_t sWorkerCount = 0;
+    static std::vector<std::unique_ptr<WorkQueue>> sQueues;
+    static std::atomic<uint32_t> sNextExternalQueue = 0;
+    static std::vector<std::thread> sWorkers;
+    static std::atomic<bool> sStopping = false;
+
+    // Overflow for threads that could not get a deque of their own
+    static std::mutex sSharedMutex;
+    static std::deque<Job *> sShared;
+    static std::atomic<uint32_t> sSharedCount = 0;
+
+    // Idle workers sleep on sWakeEpoch; submitters only touch it when someone is asleep
+    static std::atomic<uint32_t> sSleepers = 0;
+    static std::atomic<uint32_t> sWakeEpoch = 0;
+
+    struct ThreadQueue {
+        uint32_t generation = ~0u;
+        uint32_t index = NoQueue;
+        uint32_t random = 0;
+    };
+    static thread_local ThreadQueue tQueue;
+
+    static uint32_t GetQueueIndex() {
+        const uint32_t generation = sGeneration.load(std::memory_order_relaxed);
+        if (tQueue.generation != generation) {
+            tQueue.generation = generation;
+            const uint32_t external = sNextExternalQueue.fetch_add(1, std::memory_order_relaxed);
+            tQueue.index = external < JobSystem::MaxExternalThreads ? sWorkerCount + external : NoQueue;
+        }
+        return tQueue.index;
+    }
+
+    // xorshift; only used to spread thieves over victims
+    static uint32_t NextRandom() {
+        uint32_t x = tQueue.random ? tQueue.random : static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&tQueue));
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        tQueue.random = x;
+        return x;
+    }
+
+    // Pairs with the sleeper's increment of sSleepers followed by one last search for work
+    static void Wake() {
+        if (sSleepers.load(std::memory_order_seq_cst) > 0) {
+            sWakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+            sWakeEpoch.notify_one();
+        }
+    }
+
+    static void Execute(Job *job, const uint32_t queueIndex) {
+        // Threads without a queue of their own are counted against the first one
+        WorkQueue &queue = *sQueues[queueIndex == NoQueue ? 0 : queueIndex];
+        queue.executed.fetch_add(1, std::memory_order_relaxed);
+        if (queueIndex != job->queueIndex) {
+            queue.stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        job->run();
+        delete job;
+    }
+
+    static Job *FindJob(const uint32_t queueIndex) {
+        if (queueIndex != NoQueue) {
+            if (Job *job = sQueues[queueIndex]->deque.pop()) {
+                return job;
+            }
+        }
+        if (sSharedCount.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard lock(sSharedMutex);
+            if (!sShared.empty()) {
+                Job *job = sShared.front();
+                sShared.pop_front();
+                sSharedCount.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+        const auto queueCount = static_cast<uint32_t>(sQueues.size());
+        const uint32_t first = NextRandom() % queueCount;
+        for (uint32_t i = 0; i < queueCount; i++) {
+            const uint32_t victim = (first + i) % queueCount;
+            if (victim == queueIndex) {
+                continue;
+            }
+            if (Job *job = sQueues[victim]->deque.steal()) {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool RunOne(const uint32_t queueIndex) {
+        Job *job = FindJob(queueIndex);
+        if (!job) {
+            return false;
+        }
+        Execute(job, queueIndex);
+        return true;
+    }
+
+    static void WorkerLoop(const uint32_t index) {
+        tQueue.generation = sGeneration.load(std::memory_order_relaxed);
+        tQueue.index = index;
+        tQueue.random = index * 2654435761u + 1;
+
+        while (!sStopping.load(std::memory_order_acquire)) {
+            if (RunOne(index)) {
+                continue;
+            }
+
+            // Spin briefly before sleeping; jobs tend to arrive in bursts
+            bool found = false;
+            for (int i = 0; i < 64 && !found; i++) {
+                std::this_thread::yield();
+                found = RunOne(index);
+            }
+            if (found) {
+                continue;
+            }
+
+            sSleepers.fetch_add(1, std::memory_order_seq_cst);
+            const uint32_t epoch = sWakeEpoch.load(std::memory_order_seq_cst);
+            if (!sStopping.load(std::memory_order_acquire) && !RunOne(index)) {
+                sWakeEpoch.wait(epoch, std::memory_order_seq_cst);
+            }
+            sSleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Requires sLifetimeMutex
+    static void Start(uint32_t workerCount) {
+        if (workerCount == 0) {
+            // Always at least one worker: jobs queued by a thread that never waits still have to run
+            const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        sWorkerCount = workerCount;
+        sQueues.clear();
+        for (uint32_t i = 0; i < workerCount + JobSystem::MaxExternalThreads; i++) {
+            sQueues.push_back(std::make_unique<WorkQueue>());
+        }
+        sNextExternalQueue = 0;
+        sGeneration++;
+        sStopping = false;
+        for (uint32_t i = 0; i < workerCount; i++) {
+            sWorkers.emplace_back(WorkerLoop, i);
+        }
+        sRunning.store(true, std::memory_order_release);
+    }
+
+    static void EnsureRunning() {
+        if (sRunning.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard lock(sLifetimeMutex);
+        if (!sRunning) {
+            Start(0);
+        }
+    }
+
+    void JobSystem::init(const uint32_t workerCount) {
+        std::lock_guard lock(sLifetimeMutex);
+        if (sRunning) {
+            throw std::runtime_error("JobSystem is already running!");
+        }
+        Start(workerCount);
+    }
+
+    void JobSystem::shutdown() {
+        std::lock_guard lock(sLifetimeMutex);
+        if (!sRunning) {
+            return;
+        }
+
+        sStopping.store(true, std::memory_order_release);
+        sWakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+        sWakeEpoch.notify_all();
+        for (auto &worker : sWorkers) {
+            worker.join();
+        }
+        sWorkers.clear();
+
+        // Nothing may be left behind; someone could be waiting on it
+        while (RunOne(NoQueue)) {
+        }
+        sRunning.store(false, std::memory_order_release);
+    }
+
+    bool JobSystem::isRunning() {
+        return sRunning.load(std::memory_order_acquire);
+    }
+
+    uint32_t JobSystem::getWorkerCount() {
+        EnsureRunning();
+        return sWorkerCount;
+    }
+
+    // Joins the workers before the queues they use are destroyed, for programs that never call shutdown
+    static struct ShutdownAtExit {
+        ~ShutdownAtExit() { JobSystem::shutdown(); }
+    } sShutdownAtExit;
+
+    void JobSystem::run(std::function<void()> job, JobCounter *counter) {
+        EnsureRunning();
+        if (counter) {
+            counter->mPending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const uint32_t queueIndex = GetQueueIndex();
+        auto *entry = new Job{ std::move(job), counter, queueIndex };
+        if (queueIndex == NoQueue) {
+            std::lock_guard lock(sSharedMutex);
+            sShared.push_back(entry);
+            sSharedCount.fetch_add(1, std::memory_order_seq_cst);
+        } else if (!sQueues[queueIndex]->deque.push(entry)) {
+            Execute(entry, queueIndex);
+            return;
+        }
+        Wake();
+    }
+
+    void JobSystem::wait(JobCounter &counter) {
+        if (!counter.isDone()) {
+            EnsureRunning();
+            const uint32_t queueIndex = GetQueueIndex();
+            while (!counter.isDone()) {
+                if (!RunOne(queueIndex)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(counter.mErrorMutex);
+            error = std::exchange(counter.mError, nullptr);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    static void SplitRange(const std::function<void(uint32_t, uint32_t)> &function, JobCounter &counter,
+                           const uint32_t batchSize, const uint32_t begin, uint32_t end) {
+        // Queue the upper half and keep the lower one; the oldest, largest halves are the ones thieves take
+        while (end - begin > batchSize) {
+            const uint32_t middle = begin + (end - begin) / 2;
+            JobSystem::run([&function, &counter, batchSize, middle, end] {
+                SplitRange(function, counter, batchSize, middle, end);
+            }, &counter);
+            end = middle;
+        }
+        function(begin, end);
+    }
+
+    void JobSystem::parallelFor(const uint32_t count, const std::function<void(uint32_t, uint32_t)> &function,
+                                const uint32_t minBatchSize) {
+        if (count == 0) {
+            return;
+        }
+        // Around four batches per thread leaves room to rebalance without drowning small loops in overhead
+        const uint32_t threadCount = getWorkerCount() + 1;
+        const uint32_t batchSize = std::max({ minBatchSize, 1u, (count + threadCount * 4 - 1) / (threadCount * 4) });
+        if (count <= batchSize) {
+            function(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        try {
+            SplitRange(function, counter, batchSize, 0, count);
+        } catch (...) {
+            // The queued halves still reference this frame
+            try {
+                wait(counter);
+            } catch (...) {
+            }
+            throw;
+        }
+        wait(counter);
+    }
+
+    JobSystem::Statistics JobSystem::getStatistics() {
+        std::lock_guard lock(sLifetimeMutex);
+        Statistics statistics;
+        for (const auto &queue : sQueues) {
+            statistics.executed += queue->executed.load(std::memory_order_relaxed);
+            statistics.stolen += queue->stolen.load(std::memory_order_relaxed);
+        }
+        return statistics;
+    }
+
+    JobGroup::~JobGroup() {
+        try {
+            JobSystem::wait(mCounter);
+        } catch (...) {
+            // Errors are only reported by an explicit wait
+        }
+    }
+
+    void JobGroup::run(std::function<void()> job) {
+        JobSystem::run(std::move(job), &mCounter);
+    }
+
+    void JobGroup::wait() {
+        JobSystem::wait(mCounter);
+    }
+}
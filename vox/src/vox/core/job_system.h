@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+namespace Vox {
+    struct Job;
+
+    // Number of unfinished jobs started against it. The first exception thrown by one of those jobs is kept and
+    // rethrown from JobSystem::wait.
+    class JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter &) = delete;
+        JobCounter &operator=(const JobCounter &) = delete;
+
+        bool isDone() const { return mPending.load(std::memory_order_acquire) == 0; }
+
+    private:
+        friend class JobSystem;
+        friend struct Job;
+
+        std::atomic<uint32_t> mPending = 0;
+        std::mutex mErrorMutex;
+        std::exception_ptr mError;
+    };
+
+    // Jobs that are waited for together. Waits on destruction, so jobs may reference the group's scope.
+    class JobGroup {
+    public:
+        JobGroup() = default;
+        ~JobGroup();
+        JobGroup(const JobGroup &) = delete;
+        JobGroup &operator=(const JobGroup &) = delete;
+
+        void run(std::function<void()> job);
+        // Rethrows the first exception a job threw
+        void wait();
+
+        bool isDone() const { return mCounter.isDone(); }
+
+    private:
+        JobCounter mCounter;
+    };
+
+    // Work-stealing scheduler. Every worker owns a lock-free deque: it pushes and pops at the bottom, idle workers
+    // steal from the top of the others. Threads that are not workers get a deque of their own the first time they
+    // submit, up to MaxExternalThreads; any beyond that share a locked queue.
+    //
+    // Waiting never blocks while there is work: the waiting thread runs queued jobs until its counter drops to zero, so
+    // jobs may start and wait for other jobs. Started by the first call into it; Application shuts it down.
+    class JobSystem {
+    public:
+        struct Statistics {
+            uint64_t executed = 0;
+            // Jobs run by a thread other than the one that queued them
+            uint64_t stolen = 0;
+        };
+
+        // 0 uses one worker per hardware thread besides the caller's, and at least one
+        static void init(uint32_t workerCount = 0);
+        // Runs whatever is still queued, then joins the workers
+        static void shutdown();
+        static bool isRunning();
+
+        static uint32_t getWorkerCount();
+
+        // Jobs without a counter cannot report errors and must not throw; one that does terminates the program
+        static void run(std::function<void()> job, JobCounter *counter = nullptr);
+        static void wait(JobCounter &counter);
+
+        // Calls function over consecutive [begin, end) ranges covering [0, count) and returns when all are done. The
+        // range is split in halves down to a batch size chosen from count and the thread count, never below
+        // minBatchSize; thieves take the largest halves, so uneven work still balances.
+        static void parallelFor(uint32_t count, const std::function<void(uint32_t begin, uint32_t end)> &function,
+                                uint32_t minBatchSize = 1);
+
+        static Statistics getStatistics();
+
+        // Per-thread deque capacity; a full deque runs new jobs inline
+        static constexpr uint32_t QueueCapacity = 4096;
+        static constexpr uint32_t MaxExternalThreads = 4;
+    };
+}
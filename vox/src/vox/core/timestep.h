@@ -3,7 +3,7 @@
 namespace Vox {
     class Timestep {
     public:
-        Timestep(const float time = 0.0f) : mTime(time) {
+        Timestep(const float time = 0.0f, const float alpha = 1.0f) : mTime(time), mAlpha(alpha) {
         }
 
         operator float() const { return mTime; }
@@ -11,7 +11,11 @@ namespace Vox {
         float getSeconds() const { return mTime; }
         float getMilliseconds() const { return mTime * 1000.0f; }
 
+        // How far rendering is between the last two fixed updates, in [0, 1). Always 1 without a fixed timestep.
+        float getAlpha() const { return mAlpha; }
+
     private:
         float mTime;
+        float mAlpha;
     };
 }
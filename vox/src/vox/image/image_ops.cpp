@@ -0,0 +1,325 @@
+#include "vox/image/image_ops.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+#include <stb/stb_image.h>
+
+#include "vox/image/image_ops_kernels.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace Vox::ImageOps {
+    static float SRGBToLinear(const float value) {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    const float *GetSRGBToLinearTable() {
+        static const auto sTable = [] {
+            std::array<float, 512> table{};
+            for (int i = 0; i < 256; i++) {
+                table[i] = SRGBToLinear(static_cast<float>(i) / 255.0f);
+                table[256 + i] = static_cast<float>(i) / 255.0f;
+            }
+            return table;
+        }();
+        return sTable.data();
+    }
+
+    // Encodes by comparing against the linear values halfway between consecutive sRGB codes, which rounds exactly
+    // like round(LinearToSRGB(value) * 255) without a pow per texel. A coarse table gives the starting code, so
+    // only a step or two of search is left.
+    struct SRGBEncoder {
+        static constexpr uint32_t Buckets = 4096;
+
+        std::array<float, 255> thresholds;
+        std::array<uint8_t, Buckets + 1> start;
+
+        SRGBEncoder() {
+            for (int i = 0; i < 255; i++) {
+                thresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+            }
+            for (uint32_t i = 0; i <= Buckets; i++) {
+                const float value = static_cast<float>(i) / Buckets;
+                start[i] = static_cast<uint8_t>(std::upper_bound(thresholds.begin(), thresholds.end(), value) -
+                                                thresholds.begin());
+            }
+        }
+
+        uint8_t encode(const float value) const {
+            const float clamped = std::clamp(value, 0.0f, 1.0f);
+            uint32_t code = start[static_cast<uint32_t>(clamped * Buckets)];
+            while (code < 255 && thresholds[code] <= clamped) {
+                code++;
+            }
+            return static_cast<uint8_t>(code);
+        }
+    };
+
+    static const SRGBEncoder &GetSRGBEncoder() {
+        static const SRGBEncoder sEncoder;
+        return sEncoder;
+    }
+
+    // ---Scalar kernels -------------
+
+    static void FlipVerticalScalar(uint8_t *pixels, const size_t rowBytes, const uint32_t height) {
+        for (uint32_t y = 0; y < height / 2; y++) {
+            uint8_t *top = pixels + rowBytes * y;
+            uint8_t *bottom = pixels + rowBytes * (height - 1 - y);
+            for (size_t i = 0; i < rowBytes; i++) {
+                std::swap(top[i], bottom[i]);
+            }
+        }
+    }
+
+    static void ExpandRGBToRGBAScalar(const uint8_t *src, uint8_t *dst, const size_t pixelCount) {
+        for (size_t i = 0; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+    }
+
+    static void PremultiplyAlphaScalar(uint8_t *rgba, const size_t pixelCount) {
+        for (size_t i = 0; i < pixelCount; i++) {
+            uint8_t *pixel = rgba + i * 4;
+            pixel[0] = MultiplyAlpha(pixel[0], pixel[3]);
+            pixel[1] = MultiplyAlpha(pixel[1], pixel[3]);
+            pixel[2] = MultiplyAlpha(pixel[2], pixel[3]);
+        }
+    }
+
+    static void SRGBToLinearScalar(const uint8_t *rgba, float *dst, const size_t pixelCount) {
+        const float *table = GetSRGBToLinearTable();
+        for (size_t i = 0; i < pixelCount * 4; i += 4) {
+            dst[i + 0] = table[rgba[i + 0]];
+            dst[i + 1] = table[rgba[i + 1]];
+            dst[i + 2] = table[rgba[i + 2]];
+            dst[i + 3] = table[256 + rgba[i + 3]];
+        }
+    }
+
+    static void DownsampleRowsScalar(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, const uint32_t dstWidth) {
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                const uint32_t sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                dst[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    void InitScalarKernels(Kernels &kernels) {
+        kernels.flipVertical = FlipVerticalScalar;
+        kernels.expandRGBToRGBA = ExpandRGBToRGBAScalar;
+        kernels.premultiplyAlpha = PremultiplyAlphaScalar;
+        kernels.sRGBToLinear = SRGBToLinearScalar;
+        kernels.downsampleRows = DownsampleRowsScalar;
+    }
+
+    // ---Dispatch -------------------
+
+    static bool CPUSupportsAVX2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        // The OS must save the YMM registers as well
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    static SimdLevel DetectSimdLevel() {
+        Kernels kernels{};
+        if (InitAVX2Kernels(kernels) && CPUSupportsAVX2()) {
+            return SimdLevel::AVX2;
+        }
+        if (InitSSE2Kernels(kernels)) {
+            return SimdLevel::SSE2;
+        }
+        if (InitNEONKernels(kernels)) {
+            return SimdLevel::NEON;
+        }
+        return SimdLevel::Scalar;
+    }
+
+    static Kernels BuildKernels(const SimdLevel level) {
+        Kernels kernels{};
+        InitScalarKernels(kernels);
+        switch (level) {
+            case SimdLevel::AVX2:
+                // AVX2 only replaces the kernels that benefit from the wider registers
+                InitSSE2Kernels(kernels);
+                InitAVX2Kernels(kernels);
+                break;
+            case SimdLevel::SSE2:
+                InitSSE2Kernels(kernels);
+                break;
+            case SimdLevel::NEON:
+                InitNEONKernels(kernels);
+                break;
+            default:
+                break;
+        }
+        return kernels;
+    }
+
+    static const SimdLevel sSupportedLevel = DetectSimdLevel();
+    static const Kernels sLevelKernels[] = {
+        BuildKernels(SimdLevel::Scalar), BuildKernels(SimdLevel::SSE2), BuildKernels(SimdLevel::AVX2),
+        BuildKernels(SimdLevel::NEON)
+    };
+    static std::atomic<SimdLevel> sLevel = sSupportedLevel;
+
+    static const Kernels &GetKernels() {
+        return sLevelKernels[static_cast<int>(sLevel.load(std::memory_order_relaxed))];
+    }
+
+    SimdLevel getSupportedSimdLevel() {
+        return sSupportedLevel;
+    }
+
+    SimdLevel getSimdLevel() {
+        return sLevel;
+    }
+
+    void setSimdLevel(const SimdLevel level) {
+        // NEON and the x86 levels are mutually exclusive, so anything unsupported falls back to the best level
+        // below it
+        const bool supported = level == SimdLevel::Scalar || level == sSupportedLevel ||
+                               (level == SimdLevel::SSE2 && sSupportedLevel == SimdLevel::AVX2);
+        sLevel = supported ? level : sSupportedLevel;
+    }
+
+    const char *getSimdLevelName(const SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar: return "Scalar";
+            case SimdLevel::SSE2: return "SSE2";
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::NEON: return "NEON";
+            default: return "Unknown";
+        }
+    }
+
+    // ---Operations -----------------
+
+    void flipVertical(uint8_t *pixels, const size_t rowBytes, const uint32_t height) {
+        GetKernels().flipVertical(pixels, rowBytes, height);
+    }
+
+    void expandRGBToRGBA(const uint8_t *src, uint8_t *dst, const size_t pixelCount) {
+        GetKernels().expandRGBToRGBA(src, dst, pixelCount);
+    }
+
+    void premultiplyAlpha(uint8_t *rgba, const size_t pixelCount) {
+        GetKernels().premultiplyAlpha(rgba, pixelCount);
+    }
+
+    void sRGBToLinear(const uint8_t *rgba, float *dst, const size_t pixelCount) {
+        GetKernels().sRGBToLinear(rgba, dst, pixelCount);
+    }
+
+    void downsample(const uint8_t *src, const uint32_t width, const uint32_t height, uint8_t *dst, const bool sRGB) {
+        const uint32_t dstWidth = std::max(1u, width / 2);
+        const uint32_t dstHeight = std::max(1u, height / 2);
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        const auto &kernels = GetKernels();
+
+        if (!sRGB && width >= 2 && height >= 2) {
+            for (uint32_t y = 0; y < dstHeight; y++) {
+                kernels.downsampleRows(src + rowBytes * y * 2, src + rowBytes * (y * 2 + 1),
+                                       dst + static_cast<size_t>(dstWidth) * 4 * y, dstWidth);
+            }
+            return;
+        }
+
+        // Single texel wide or tall images clamp at the edge, reusing the last row or column
+        const SRGBEncoder &encoder = GetSRGBEncoder();
+        std::vector<float> rows[2] = { std::vector<float>(rowBytes), std::vector<float>(rowBytes) };
+        for (uint32_t y = 0; y < dstHeight; y++) {
+            const uint8_t *row0 = src + rowBytes * std::min(y * 2, height - 1);
+            const uint8_t *row1 = src + rowBytes * std::min(y * 2 + 1, height - 1);
+            uint8_t *out = dst + static_cast<size_t>(dstWidth) * 4 * y;
+
+            if (!sRGB) {
+                for (uint32_t x = 0; x < dstWidth; x++) {
+                    const uint32_t x0 = std::min(x * 2, width - 1) * 4;
+                    const uint32_t x1 = std::min(x * 2 + 1, width - 1) * 4;
+                    for (uint32_t c = 0; c < 4; c++) {
+                        const uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                        out[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+                    }
+                }
+                continue;
+            }
+
+            kernels.sRGBToLinear(row0, rows[0].data(), width);
+            kernels.sRGBToLinear(row1, rows[1].data(), width);
+            for (uint32_t x = 0; x < dstWidth; x++) {
+                const uint32_t x0 = std::min(x * 2, width - 1) * 4;
+                const uint32_t x1 = std::min(x * 2 + 1, width - 1) * 4;
+                for (uint32_t c = 0; c < 3; c++) {
+                    const float sum = rows[0][x0 + c] + rows[0][x1 + c] + rows[1][x0 + c] + rows[1][x1 + c];
+                    out[x * 4 + c] = encoder.encode(sum * 0.25f);
+                }
+                const uint32_t alpha = row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3];
+                out[x * 4 + 3] = static_cast<uint8_t>((alpha + 2) >> 2);
+            }
+        }
+    }
+
+    DecodedImage decode(const std::span<const uint8_t> data, const DecodeOptions &options) {
+        const auto size = static_cast<int>(data.size());
+        int width, height, channels;
+        if (!stbi_info_from_memory(data.data(), size, &width, &height, &channels)) {
+            throw std::runtime_error("Failed to load image!");
+        }
+
+        // stb_image flips and expands row by row during decode, so both are left to the kernels here
+        const int desiredChannels = channels == 3 ? 3 : 4;
+        stbi_set_flip_vertically_on_load_thread(0);
+        stbi_uc *pixels = stbi_load_from_memory(data.data(), size, &width, &height, &channels, desiredChannels);
+        if (!pixels) {
+            throw std::runtime_error("Failed to load image!");
+        }
+
+        DecodedImage image;
+        image.width = static_cast<uint32_t>(width);
+        image.height = static_cast<uint32_t>(height);
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        if (desiredChannels == 3 && options.expandRGB) {
+            image.channels = 4;
+            image.pixels.resize(pixelCount * 4);
+            expandRGBToRGBA(pixels, image.pixels.data(), pixelCount);
+        } else {
+            image.channels = desiredChannels;
+            image.pixels.assign(pixels, pixels + pixelCount * desiredChannels);
+        }
+        stbi_image_free(pixels);
+
+        flipVertical(image.pixels.data(), static_cast<size_t>(width) * image.channels, image.height);
+        if (options.premultiplyAlpha && image.channels == 4) {
+            premultiplyAlpha(image.pixels.data(), pixelCount);
+        }
+        return image;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Vox::ImageOps {
+    // Pixel conversions run on texture import. Every operation has a scalar version and is accelerated where the CPU
+    // allows; the widest supported instruction set is picked at startup.
+    enum class SimdLevel {
+        Scalar, SSE2, AVX2, NEON
+    };
+
+    SimdLevel getSupportedSimdLevel();
+    SimdLevel getSimdLevel();
+    // Clamped to what the CPU supports. Meant for benchmarks and for checking kernels against the scalar versions.
+    void setSimdLevel(SimdLevel level);
+    const char *getSimdLevelName(SimdLevel level);
+
+    // Reverses the row order in place
+    void flipVertical(uint8_t *pixels, size_t rowBytes, uint32_t height);
+    // dst must hold pixelCount * 4 bytes; alpha is set to opaque
+    void expandRGBToRGBA(const uint8_t *src, uint8_t *dst, size_t pixelCount);
+    // Rounds to nearest, so opaque pixels are unchanged
+    void premultiplyAlpha(uint8_t *rgba, size_t pixelCount);
+    // RGB is decoded from sRGB, alpha is only normalised
+    void sRGBToLinear(const uint8_t *rgba, float *dst, size_t pixelCount);
+    // 2x2 box filter of an RGBA8 image into max(1, width / 2) x max(1, height / 2). sRGB images are averaged in
+    // linear space so mips do not darken.
+    void downsample(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst, bool sRGB);
+
+    struct DecodedImage {
+        uint32_t width = 0, height = 0;
+        // 3 or 4; anything else is expanded to 4
+        uint32_t channels = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct DecodeOptions {
+        // Return 3 channel images as RGBA8 too
+        bool expandRGB = true;
+        bool premultiplyAlpha = false;
+    };
+
+    // Decodes any format stb_image understands. Rows come out bottom-up, as OpenGL expects them. Throws on failure.
+    DecodedImage decode(std::span<const uint8_t> data, const DecodeOptions &options = {});
+}
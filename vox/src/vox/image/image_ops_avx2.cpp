@@ -0,0 +1,134 @@
+#include "vox/image/image_ops_kernels.h"
+
+// Built with AVX2 code generation enabled (see vox/CMakeLists.txt) and only called after a CPUID check
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace Vox::ImageOps {
+#ifdef __AVX2__
+    static void FlipVerticalAVX2(uint8_t *pixels, const size_t rowBytes, const uint32_t height) {
+        for (uint32_t y = 0; y < height / 2; y++) {
+            uint8_t *top = pixels + rowBytes * y;
+            uint8_t *bottom = pixels + rowBytes * (height - 1 - y);
+            size_t i = 0;
+            for (; i + 32 <= rowBytes; i += 32) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(top + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bottom + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(top + i), b);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(bottom + i), a);
+            }
+            for (; i < rowBytes; i++) {
+                const uint8_t value = top[i];
+                top[i] = bottom[i];
+                bottom[i] = value;
+            }
+        }
+    }
+
+    // Each 128-bit lane takes four pixels from its own load; the second load overlaps the first so the shuffle
+    // never has to cross lanes. It also reads four bytes past the eight pixels, hence the loop bound.
+    static void ExpandRGBToRGBAAVX2(const uint8_t *src, uint8_t *dst, const size_t pixelCount) {
+        const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000));
+        size_t i = 0;
+        for (; i + 10 <= pixelCount; i += 8) {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 12));
+            const __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            const __m256i rgba = _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), alpha);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), rgba);
+        }
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+    }
+
+    static __m256i PremultiplyPairAVX2(const __m256i pixels) {
+        const __m256i alphaShuffle = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1,
+                                                      6, 7, 6, 7, 6, 7, -1, -1, 14, 15, 14, 15, 14, 15, -1, -1);
+        const __m256i alphaOne = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+        const __m256i factor = _mm256_or_si256(_mm256_shuffle_epi8(pixels, alphaShuffle), alphaOne);
+        const __m256i value = _mm256_add_epi16(_mm256_mullo_epi16(pixels, factor), _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8);
+    }
+
+    // Unpack and pack both work within lanes, so pixels come back out in their original order
+    static void PremultiplyAlphaAVX2(uint8_t *rgba, const size_t pixelCount) {
+        const __m256i zero = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= pixelCount; i += 8) {
+            const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rgba + i * 4));
+            const __m256i low = PremultiplyPairAVX2(_mm256_unpacklo_epi8(pixels, zero));
+            const __m256i high = PremultiplyPairAVX2(_mm256_unpackhi_epi8(pixels, zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(rgba + i * 4), _mm256_packus_epi16(low, high));
+        }
+        for (; i < pixelCount; i++) {
+            uint8_t *pixel = rgba + i * 4;
+            pixel[0] = MultiplyAlpha(pixel[0], pixel[3]);
+            pixel[1] = MultiplyAlpha(pixel[1], pixel[3]);
+            pixel[2] = MultiplyAlpha(pixel[2], pixel[3]);
+        }
+    }
+
+    // Alpha lanes index the second half of the table
+    static void SRGBToLinearAVX2(const uint8_t *rgba, float *dst, const size_t pixelCount) {
+        const float *table = GetSRGBToLinearTable();
+        const __m256i alphaOffset = _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256);
+        size_t i = 0;
+        for (; i + 2 <= pixelCount; i += 2) {
+            const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(rgba + i * 4));
+            const __m256i indices = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), alphaOffset);
+            _mm256_storeu_ps(dst + i * 4, _mm256_i32gather_ps(table, indices, 4));
+        }
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = table[rgba[i * 4 + 0]];
+            dst[i * 4 + 1] = table[rgba[i * 4 + 1]];
+            dst[i * 4 + 2] = table[rgba[i * 4 + 2]];
+            dst[i * 4 + 3] = table[256 + rgba[i * 4 + 3]];
+        }
+    }
+
+    // Eight source pixels from each row make four destination pixels
+    static void DownsampleRowsAVX2(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, const uint32_t dstWidth) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i round = _mm256_set1_epi16(2);
+        uint32_t x = 0;
+        for (; x + 4 <= dstWidth; x += 4) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x * 8));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x * 8));
+            // Per lane: pixels 0 and 1 then 2 and 3 (and 4 to 7 in the upper lane), summed down the columns
+            const __m256i low = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+            const __m256i high = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+            const __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(low, high), _mm256_unpackhi_epi64(low, high));
+            const __m256i average = _mm256_srli_epi16(_mm256_add_epi16(sum, round), 2);
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(average, average),
+                                                            _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * 4), _mm256_castsi256_si128(packed));
+        }
+        for (; x < dstWidth; x++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                const uint32_t sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                dst[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    bool InitAVX2Kernels(Kernels &kernels) {
+        kernels.flipVertical = FlipVerticalAVX2;
+        kernels.expandRGBToRGBA = ExpandRGBToRGBAAVX2;
+        kernels.premultiplyAlpha = PremultiplyAlphaAVX2;
+        kernels.sRGBToLinear = SRGBToLinearAVX2;
+        kernels.downsampleRows = DownsampleRowsAVX2;
+        return true;
+    }
+#else
+    bool InitAVX2Kernels(Kernels &) {
+        return false;
+    }
+#endif
+}
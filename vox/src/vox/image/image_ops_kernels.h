@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Internal to the image module. Each instruction set fills in the entries it accelerates, on top of the scalar
+// table.
+namespace Vox::ImageOps {
+    struct Kernels {
+        void (*flipVertical)(uint8_t *pixels, size_t rowBytes, uint32_t height);
+        void (*expandRGBToRGBA)(const uint8_t *src, uint8_t *dst, size_t pixelCount);
+        void (*premultiplyAlpha)(uint8_t *rgba, size_t pixelCount);
+        void (*sRGBToLinear)(const uint8_t *rgba, float *dst, size_t pixelCount);
+        // Averages 2x2 blocks of two adjacent RGBA8 rows into dstWidth pixels; the rows hold at least
+        // dstWidth * 2 pixels
+        void (*downsampleRows)(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, uint32_t dstWidth);
+    };
+
+    // Shared by every implementation so results match exactly: 256 sRGB decodes followed by 256 alpha values
+    const float *GetSRGBToLinearTable();
+
+    void InitScalarKernels(Kernels &kernels);
+    // Return false when the instruction set is not compiled in for this architecture
+    bool InitSSE2Kernels(Kernels &kernels);
+    bool InitAVX2Kernels(Kernels &kernels);
+    bool InitNEONKernels(Kernels &kernels);
+
+    // Exact integer form of c * a / 255, rounded to nearest. Internal linkage: the AVX2 file is built with -mavx2,
+    // and an inline function could have that file's out-of-line copy picked for every caller.
+    static inline uint8_t MultiplyAlpha(const uint32_t color, const uint32_t alpha) {
+        const uint32_t value = color * alpha + 128;
+        return static_cast<uint8_t>((value + (value >> 8)) >> 8);
+    }
+}
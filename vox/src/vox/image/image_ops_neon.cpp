@@ -0,0 +1,106 @@
+#include "vox/image/image_ops_kernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define VX_IMAGE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Vox::ImageOps {
+#ifdef VX_IMAGE_NEON
+    static void FlipVerticalNEON(uint8_t *pixels, const size_t rowBytes, const uint32_t height) {
+        for (uint32_t y = 0; y < height / 2; y++) {
+            uint8_t *top = pixels + rowBytes * y;
+            uint8_t *bottom = pixels + rowBytes * (height - 1 - y);
+            size_t i = 0;
+            for (; i + 16 <= rowBytes; i += 16) {
+                const uint8x16_t a = vld1q_u8(top + i);
+                const uint8x16_t b = vld1q_u8(bottom + i);
+                vst1q_u8(top + i, b);
+                vst1q_u8(bottom + i, a);
+            }
+            for (; i < rowBytes; i++) {
+                const uint8_t value = top[i];
+                top[i] = bottom[i];
+                bottom[i] = value;
+            }
+        }
+    }
+
+    // Structured loads and stores interleave the channels for free
+    static void ExpandRGBToRGBANEON(const uint8_t *src, uint8_t *dst, const size_t pixelCount) {
+        size_t i = 0;
+        for (; i + 16 <= pixelCount; i += 16) {
+            const uint8x16x3_t rgb = vld3q_u8(src + i * 3);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + i * 4, rgba);
+        }
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+    }
+
+    // (x + 128 + ((x + 128) >> 8)) >> 8, the same rounding as MultiplyAlpha
+    static uint8x8_t MultiplyAlphaNEON(const uint8x8_t color, const uint8x8_t alpha) {
+        const uint16x8_t value = vmull_u8(color, alpha);
+        return vraddhn_u16(value, vrshrq_n_u16(value, 8));
+    }
+
+    static void PremultiplyAlphaNEON(uint8_t *rgba, const size_t pixelCount) {
+        size_t i = 0;
+        for (; i + 8 <= pixelCount; i += 8) {
+            uint8x8x4_t pixels = vld4_u8(rgba + i * 4);
+            pixels.val[0] = MultiplyAlphaNEON(pixels.val[0], pixels.val[3]);
+            pixels.val[1] = MultiplyAlphaNEON(pixels.val[1], pixels.val[3]);
+            pixels.val[2] = MultiplyAlphaNEON(pixels.val[2], pixels.val[3]);
+            vst4_u8(rgba + i * 4, pixels);
+        }
+        for (; i < pixelCount; i++) {
+            uint8_t *pixel = rgba + i * 4;
+            pixel[0] = MultiplyAlpha(pixel[0], pixel[3]);
+            pixel[1] = MultiplyAlpha(pixel[1], pixel[3]);
+            pixel[2] = MultiplyAlpha(pixel[2], pixel[3]);
+        }
+    }
+
+    // Four source pixels from each row make two destination pixels
+    static void DownsampleRowsNEON(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, const uint32_t dstWidth) {
+        uint32_t x = 0;
+        for (; x + 2 <= dstWidth; x += 2) {
+            const uint8x16_t a = vld1q_u8(row0 + x * 8);
+            const uint8x16_t b = vld1q_u8(row1 + x * 8);
+            // Pixels 0 and 1, then 2 and 3, summed down the columns
+            const uint16x8_t low = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+            const uint16x8_t high = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+            const uint16x8_t sum = vcombine_u16(vadd_u16(vget_low_u16(low), vget_high_u16(low)),
+                                                vadd_u16(vget_low_u16(high), vget_high_u16(high)));
+            vst1_u8(dst + x * 4, vrshrn_n_u16(sum, 2));
+        }
+        for (; x < dstWidth; x++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                const uint32_t sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                dst[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    // sRGBToLinear stays scalar: it is a table lookup per channel and NEON has no gather
+    bool InitNEONKernels(Kernels &kernels) {
+        kernels.flipVertical = FlipVerticalNEON;
+        kernels.expandRGBToRGBA = ExpandRGBToRGBANEON;
+        kernels.premultiplyAlpha = PremultiplyAlphaNEON;
+        kernels.downsampleRows = DownsampleRowsNEON;
+        return true;
+    }
+#else
+    bool InitNEONKernels(Kernels &) {
+        return false;
+    }
+#endif
+}
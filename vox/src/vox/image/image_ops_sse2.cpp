@@ -0,0 +1,117 @@
+#include "vox/image/image_ops_kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VX_IMAGE_SSE2 1
+#include <emmintrin.h>
+#include <cstring>
+#endif
+
+namespace Vox::ImageOps {
+#ifdef VX_IMAGE_SSE2
+    static void FlipVerticalSSE2(uint8_t *pixels, const size_t rowBytes, const uint32_t height) {
+        for (uint32_t y = 0; y < height / 2; y++) {
+            uint8_t *top = pixels + rowBytes * y;
+            uint8_t *bottom = pixels + rowBytes * (height - 1 - y);
+            size_t i = 0;
+            for (; i + 16 <= rowBytes; i += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(top + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bottom + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(top + i), b);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(bottom + i), a);
+            }
+            for (; i < rowBytes; i++) {
+                const uint8_t value = top[i];
+                top[i] = bottom[i];
+                bottom[i] = value;
+            }
+        }
+    }
+
+    // Without a byte shuffle each pixel is read as an unaligned 32-bit word. The last read of a group takes one
+    // byte from the next pixel, so the final group is left to the scalar tail.
+    static void ExpandRGBToRGBASSE2(const uint8_t *src, uint8_t *dst, const size_t pixelCount) {
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+        size_t i = 0;
+        for (; i + 5 <= pixelCount; i += 4) {
+            int words[4];
+            std::memcpy(&words[0], src + i * 3 + 0, 4);
+            std::memcpy(&words[1], src + i * 3 + 3, 4);
+            std::memcpy(&words[2], src + i * 3 + 6, 4);
+            std::memcpy(&words[3], src + i * 3 + 9, 4);
+            const __m128i rgb = _mm_setr_epi32(words[0], words[1], words[2], words[3]);
+            const __m128i rgba = _mm_or_si128(_mm_and_si128(rgb, _mm_set1_epi32(0x00ffffff)), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), rgba);
+        }
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 3 + 0];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+    }
+
+    // Two pixels widened to 16 bits. Alpha lanes are multiplied by 255, which the rounding maps back to alpha.
+    static __m128i PremultiplyPairSSE2(const __m128i pixels) {
+        const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        const __m128i alphaOne = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+        const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                                                  _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i factor = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaOne);
+        const __m128i value = _mm_add_epi16(_mm_mullo_epi16(pixels, factor), _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    }
+
+    static void PremultiplyAlphaSSE2(uint8_t *rgba, const size_t pixelCount) {
+        const __m128i zero = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= pixelCount; i += 4) {
+            const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba + i * 4));
+            const __m128i low = PremultiplyPairSSE2(_mm_unpacklo_epi8(pixels, zero));
+            const __m128i high = PremultiplyPairSSE2(_mm_unpackhi_epi8(pixels, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(rgba + i * 4), _mm_packus_epi16(low, high));
+        }
+        for (; i < pixelCount; i++) {
+            uint8_t *pixel = rgba + i * 4;
+            pixel[0] = MultiplyAlpha(pixel[0], pixel[3]);
+            pixel[1] = MultiplyAlpha(pixel[1], pixel[3]);
+            pixel[2] = MultiplyAlpha(pixel[2], pixel[3]);
+        }
+    }
+
+    // Four source pixels from each row make two destination pixels
+    static void DownsampleRowsSSE2(const uint8_t *row0, const uint8_t *row1, uint8_t *dst, const uint32_t dstWidth) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi16(2);
+        uint32_t x = 0;
+        for (; x + 2 <= dstWidth; x += 2) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 8));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 8));
+            // Lanes hold pixels 0 and 1, then 2 and 3, summed down the columns
+            const __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+            const __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+            const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+            const __m128i average = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + x * 4), _mm_packus_epi16(average, average));
+        }
+        for (; x < dstWidth; x++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                const uint32_t sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+                dst[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    // sRGBToLinear stays scalar: it is a table lookup per channel and SSE2 has no gather
+    bool InitSSE2Kernels(Kernels &kernels) {
+        kernels.flipVertical = FlipVerticalSSE2;
+        kernels.expandRGBToRGBA = ExpandRGBToRGBASSE2;
+        kernels.premultiplyAlpha = PremultiplyAlphaSSE2;
+        kernels.downsampleRows = DownsampleRowsSSE2;
+        return true;
+    }
+#else
+    bool InitSSE2Kernels(Kernels &) {
+        return false;
+    }
+#endif
+}
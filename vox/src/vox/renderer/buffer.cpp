@@ -1,31 +1,65 @@
 #include "vox/renderer/buffer.h"
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 #include "platform/opengl/buffer.h"
 
 namespace Vox {
-    VertexBuffer *VertexBuffer::create(float *vertices, uint32_t size) {
+    std::shared_ptr<VertexBuffer> VertexBuffer::create(uint32_t size, BufferUsage usage) {
         switch (Renderer::getAPI()) {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is currently not supported!");
             case RendererAPI::API::OpenGL:
-                return new OpenGLVertexBuffer(vertices, size);
+                return RenderThread::call([&] { return std::make_shared<OpenGLVertexBuffer>(size, usage); });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
     }
 
-    IndexBuffer *IndexBuffer::create(uint32_t *indices, uint32_t count) {
+    std::shared_ptr<VertexBuffer> VertexBuffer::create(float *vertices, uint32_t size) {
         switch (Renderer::getAPI()) {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is currently not supported!");
             case RendererAPI::API::OpenGL:
-                return new OpenGLIndexBuffer(indices, count);
+                return RenderThread::call([&] { return std::make_shared<OpenGLVertexBuffer>(vertices, size); });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
     }
+
+    std::shared_ptr<IndexBuffer> IndexBuffer::create(uint32_t capacity, BufferUsage usage, IndexType type) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is currently not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return std::make_shared<OpenGLIndexBuffer>(capacity, usage, type); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<IndexBuffer> IndexBuffer::create(const void *indices, uint32_t count, IndexType type) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is currently not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return std::make_shared<OpenGLIndexBuffer>(indices, count, type); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<IndexBuffer> IndexBuffer::create(uint32_t *indices, uint32_t count) {
+        const uint32_t maxIndex = count > 0 ? *std::max_element(indices, indices + count) : 0;
+        if (SelectIndexType(maxIndex) == IndexType::UInt32) {
+            return create(static_cast<const void *>(indices), count, IndexType::UInt32);
+        }
+
+        std::vector<uint16_t> narrowed(indices, indices + count);
+        return create(static_cast<const void *>(narrowed.data()), count, IndexType::UInt16);
+    }
 }
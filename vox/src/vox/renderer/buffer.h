@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -38,11 +39,16 @@ namespace Vox {
         uint32_t size;
         uint32_t offset;
         bool normalized;
+        // 0 advances the attribute per vertex, N advances it once every N instances
+        uint32_t stepRate;
 
-        BufferElement(ShaderDataType type, const std::string &name, bool normalized = false) : type(type),
-            name(name), size(ShaderDataTypeSize(type)), offset(0), normalized(normalized) {
+        BufferElement(ShaderDataType type, const std::string &name, bool normalized = false, uint32_t stepRate = 0) :
+            type(type), name(name), size(ShaderDataTypeSize(type)), offset(0), normalized(normalized),
+            stepRate(stepRate) {
         }
 
+        bool isPerInstance() const { return stepRate != 0; }
+
         uint32_t getComponentCount() const {
             switch (type) {
                 case ShaderDataType::Float: return 1;
@@ -94,6 +100,16 @@ namespace Vox {
         uint32_t mStride = 0;
     };
 
+    enum class BufferUsage {
+        // Uploaded once at creation
+        Static,
+        // Updated occasionally in place with setData
+        Dynamic,
+        // Rewritten every frame, front to back: a write at offset 0 starts a fresh store, and later writes in the
+        // same frame must append after it
+        Stream,
+    };
+
     class VertexBuffer {
     public:
         virtual ~VertexBuffer() {}
@@ -101,12 +117,36 @@ namespace Vox {
         virtual void bind() const = 0;
         virtual void unbind() const = 0;
 
+        // Size and offset are in bytes
+        virtual void setData(const void *data, uint32_t size, uint32_t offset = 0) = 0;
+
         virtual const BufferLayout &getLayout() const = 0;
         virtual void setLayout(const BufferLayout &) = 0;
 
-        static VertexBuffer *create(float *vertices, uint32_t size);
+        static std::shared_ptr<VertexBuffer> create(uint32_t size, BufferUsage usage = BufferUsage::Dynamic);
+        static std::shared_ptr<VertexBuffer> create(float *vertices, uint32_t size);
     };
 
+    enum class IndexType {
+        UInt8, UInt16, UInt32
+    };
+
+    static uint32_t IndexTypeSize(IndexType type) {
+        switch (type) {
+            case IndexType::UInt8: return 1;
+            case IndexType::UInt16: return 2;
+            case IndexType::UInt32: return 4;
+            default:
+                throw std::runtime_error("Unknown IndexType!");
+        }
+    }
+
+    // Narrowest type that can address maxIndex. 8-bit indices are not picked automatically: several desktop GPUs
+    // have no native support for them and the driver converts them on every draw.
+    static IndexType SelectIndexType(uint32_t maxIndex) {
+        return maxIndex <= 0xffff ? IndexType::UInt16 : IndexType::UInt32;
+    }
+
     class IndexBuffer {
     public:
         virtual ~IndexBuffer() {}
@@ -114,8 +154,17 @@ namespace Vox {
         virtual void bind() const = 0;
         virtual void unbind() const = 0;
 
+        // Indices must already be in the buffer's type. Count and offset are in indices; the buffer's count becomes
+        // offset + count.
+        virtual void setData(const void *indices, uint32_t count, uint32_t offset = 0) = 0;
+
         virtual uint32_t getCount() const = 0;
+        virtual IndexType getType() const = 0;
 
-        static IndexBuffer *create(uint32_t *indices, uint32_t count);
+        // Creates an empty buffer with room for capacity indices
+        static std::shared_ptr<IndexBuffer> create(uint32_t capacity, BufferUsage usage, IndexType type = IndexType::UInt32);
+        static std::shared_ptr<IndexBuffer> create(const void *indices, uint32_t count, IndexType type);
+        // Stores the indices in the narrowest type that fits them, see SelectIndexType
+        static std::shared_ptr<IndexBuffer> create(uint32_t *indices, uint32_t count);
     };
 }
@@ -7,5 +7,9 @@ namespace Vox {
         
         virtual void init() = 0;
         virtual void swapBuffers() = 0;
+
+        // Binds the context to the calling thread, or unbinds it so another thread can take it
+        virtual void makeCurrent() = 0;
+        virtual void releaseCurrent() = 0;
     };
 }
@@ -1,24 +1,98 @@
 #pragma once
 
+#include <cstring>
+
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer_api.h"
 
 namespace Vox {
+    // Everything that talks to the context goes through RenderThread::submit, so it is recorded while the render
+    // thread is active and runs directly otherwise.
     class RenderCommand {
     public:
         static void init() {
             sRendererAPI->init();
         }
 
+        static void shutdown() {
+            sRendererAPI->shutdown();
+        }
+
+        static void beginFrame() {
+            RenderThread::submit([] { sRendererAPI->beginFrame(); });
+        }
+
+        static void endFrame() {
+            RenderThread::submit([] { sRendererAPI->endFrame(); });
+        }
+
+        static RendererAPI::FrameStatistics getFrameStatistics() {
+            // The render thread rolls the counters, so they are read there
+            return RenderThread::call([] { return sRendererAPI->getFrameStatistics(); });
+        }
+
+        static const RendererAPI::Capabilities &getCapabilities() {
+            return sRendererAPI->getCapabilities();
+        }
+
         static void setClearColor(const glm::vec4 &color) {
-            sRendererAPI->setClearColor(color);
+            RenderThread::submit([color] { sRendererAPI->setClearColor(color); });
         }
 
         static void clear() {
-            sRendererAPI->clear();
+            RenderThread::submit([] { sRendererAPI->clear(); });
+        }
+
+        // Draws of a vertex array that has been destroyed by the time the command runs are skipped
+        static void drawIndexed(const VertexArrayHandle vertexArray, uint32_t indexCount = 0) {
+            RenderThread::submit([vertexArray, indexCount] {
+                if (const VertexArray *resolved = VertexArray::resolve(vertexArray)) {
+                    sRendererAPI->drawIndexed(*resolved, indexCount);
+                }
+            });
+        }
+
+        static void drawIndexed(const std::shared_ptr<VertexArray> &vertexArray, uint32_t indexCount = 0) {
+            drawIndexed(vertexArray->getHandle(), indexCount);
+        }
+
+        static void drawIndexedInstanced(const VertexArrayHandle vertexArray, uint32_t instanceCount) {
+            RenderThread::submit([vertexArray, instanceCount] {
+                if (const VertexArray *resolved = VertexArray::resolve(vertexArray)) {
+                    sRendererAPI->drawIndexedInstanced(*resolved, instanceCount);
+                }
+            });
+        }
+
+        static void drawIndexedInstanced(const std::shared_ptr<VertexArray> &vertexArray, uint32_t instanceCount) {
+            drawIndexedInstanced(vertexArray->getHandle(), instanceCount);
+        }
+
+        static void multiDrawIndexed(const VertexArrayHandle vertexArray,
+                                     const RendererAPI::DrawIndexedIndirectCommand *commands,
+                                     const glm::mat4 *transforms, uint32_t drawCount) {
+            if (RenderThread::isRecording()) {
+                // The caller's arrays are gone by the time the command runs
+                auto *commandsCopy = static_cast<RendererAPI::DrawIndexedIndirectCommand *>(RenderThread::allocate(
+                    sizeof(*commands) * drawCount, alignof(RendererAPI::DrawIndexedIndirectCommand)));
+                auto *transformsCopy = static_cast<glm::mat4 *>(
+                    RenderThread::allocate(sizeof(*transforms) * drawCount, alignof(glm::mat4)));
+                std::memcpy(commandsCopy, commands, sizeof(*commands) * drawCount);
+                std::memcpy(transformsCopy, transforms, sizeof(*transforms) * drawCount);
+                commands = commandsCopy;
+                transforms = transformsCopy;
+            }
+            RenderThread::submit([vertexArray, commands, transforms, drawCount] {
+                if (const VertexArray *resolved = VertexArray::resolve(vertexArray)) {
+                    sRendererAPI->multiDrawIndexed(*resolved, commands, transforms, drawCount);
+                }
+            });
         }
 
-        static void drawIndexed(const std::shared_ptr<VertexArray> &vertexArray) {
-            sRendererAPI->drawIndexed(vertexArray);
+        static void multiDrawIndexed(const std::shared_ptr<VertexArray> &vertexArray,
+                                     const RendererAPI::DrawIndexedIndirectCommand *commands,
+                                     const glm::mat4 *transforms, uint32_t drawCount) {
+            multiDrawIndexed(vertexArray->getHandle(), commands, transforms, drawCount);
         }
 
     private:
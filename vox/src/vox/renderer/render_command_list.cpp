@@ -0,0 +1,39 @@
+#include "vox/renderer/render_command_list.h"
+
+#include <exception>
+
+namespace Vox {
+    void RenderCommandList::execute() {
+        Header *header = mHead;
+        mHead = mTail = nullptr;
+
+        std::exception_ptr error;
+        while (header) {
+            Header *next = header->next;
+            if (error) {
+                header->run(header, false);
+            } else {
+                try {
+                    header->run(header, true);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            header = next;
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void RenderCommandList::clear() {
+        Header *header = mHead;
+        mHead = mTail = nullptr;
+        while (header) {
+            Header *next = header->next;
+            header->run(header, false);
+            header = next;
+        }
+    }
+}
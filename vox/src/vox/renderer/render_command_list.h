@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "vox/core/frame_allocator.h"
+
+namespace Vox {
+    // Commands recorded by one thread to be run in order by another. Each command is a closure stored in the
+    // FrameAllocator together with any data allocated for it, so a list has to be executed or cleared within
+    // FrameAllocator::FrameCount frames of being recorded.
+    class RenderCommandList {
+    public:
+        RenderCommandList() = default;
+        ~RenderCommandList() { clear(); }
+        RenderCommandList(const RenderCommandList &) = delete;
+        RenderCommandList &operator=(const RenderCommandList &) = delete;
+
+        template<typename F>
+        void record(F &&command) {
+            using Command = Entry<std::decay_t<F>>;
+            void *memory = allocate(sizeof(Command), alignof(Command));
+            Header *entry = new (memory) Command(std::forward<F>(command));
+            if (mTail) {
+                mTail->next = entry;
+            } else {
+                mHead = entry;
+            }
+            mTail = entry;
+        }
+
+        // Memory that stays valid until the list is executed or cleared
+        void *allocate(const size_t size, const size_t alignment = alignof(std::max_align_t)) {
+            return FrameAllocator::allocate(size, alignment);
+        }
+
+        // Runs every command in recording order and empties the list. If a command throws, the rest are destroyed
+        // without running and the exception is rethrown.
+        void execute();
+        // Destroys every command without running it
+        void clear();
+
+        bool empty() const { return mHead == nullptr; }
+
+    private:
+        struct Header {
+            void (*run)(Header *header, bool execute) = nullptr;
+            Header *next = nullptr;
+        };
+
+        template<typename F>
+        struct Entry : Header {
+            explicit Entry(F &&function) : command(std::move(function)) { run = &Run; }
+            explicit Entry(const F &function) : command(function) { run = &Run; }
+
+            static void Run(Header *header, const bool execute) {
+                auto *entry = static_cast<Entry *>(header);
+                // Destroyed even when the command throws
+                struct Destroy {
+                    Entry *entry;
+                    ~Destroy() { entry->~Entry(); }
+                } destroy{ entry };
+                if (execute) {
+                    entry->command();
+                }
+            }
+
+            F command;
+        };
+
+        Header *mHead = nullptr;
+        Header *mTail = nullptr;
+    };
+}
@@ -0,0 +1,92 @@
+#include "vox/renderer/render_queue.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Vox {
+    void RenderQueue::begin(const SortMode mode, const glm::mat4 &viewProjection) {
+        clear();
+        mRecords.reserve(mExpectedSize);
+        mEntries.reserve(mExpectedSize);
+        mMode = mode;
+        mViewProjection = viewProjection;
+    }
+
+    uint32_t RenderQueue::intern(IdMap &ids, const uint32_t handle) {
+        // Ids are handed out in first-seen order; 0 is reserved for "none"
+        const auto [it, inserted] = ids.try_emplace(handle, static_cast<uint32_t>(ids.size()) + 1);
+        return handle ? it->second : 0;
+    }
+
+    void RenderQueue::push(DrawRecord &&record, const uint8_t layer) {
+        uint64_t key = static_cast<uint64_t>(layer) << 56;
+        if (mMode == SortMode::State) {
+            // Ids wider than their field wrap around, which only costs sort quality, never correctness
+            const uint64_t shader = intern(mShaderIds, record.shader.getValue()) & 0xfff;
+            const uint64_t texture = intern(mTextureIds, record.texture.getValue()) & 0xffff;
+            const uint64_t vertexArray = intern(mVertexArrayIds, record.vertexArray.getValue()) & 0xffff;
+            // Orthographic scenes keep z in [-1, 1]
+            const float z = std::clamp(record.transform[3][2], -1.0f, 1.0f);
+            const uint64_t depth = static_cast<uint64_t>((z + 1.0f) * 0.5f * 4095.0f);
+
+            key |= shader << 44 | texture << 28 | vertexArray << 12 | depth;
+        }
+
+        mEntries.push_back({ key, static_cast<uint32_t>(mRecords.size()) });
+        mRecords.push_back(std::move(record));
+    }
+
+    void RenderQueue::retain(const std::shared_ptr<const void> &resource) {
+        if (resource) {
+            mRetained.try_emplace(resource.get(), resource);
+        }
+    }
+
+    void RenderQueue::sort() {
+        const size_t count = mEntries.size();
+        mExpectedSize = count;
+        if (count < 2) {
+            return;
+        }
+
+        // LSD radix sort over the eight key bytes. All histograms are built in one pass, and bytes that are the
+        // same for every key are skipped, so Stable mode usually costs a single scatter.
+        std::array<std::array<uint32_t, 256>, 8> histograms{};
+        for (const auto &entry : mEntries) {
+            for (uint32_t byte = 0; byte < 8; byte++) {
+                histograms[byte][(entry.key >> (byte * 8)) & 0xff]++;
+            }
+        }
+
+        mScratch.resize(count);
+        for (uint32_t byte = 0; byte < 8; byte++) {
+            auto &histogram = histograms[byte];
+            if (histogram[(mEntries[0].key >> (byte * 8)) & 0xff] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto &bucket : histogram) {
+                const uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+            for (const auto &entry : mEntries) {
+                mScratch[histogram[(entry.key >> (byte * 8)) & 0xff]++] = entry;
+            }
+            mEntries.swap(mScratch);
+        }
+    }
+
+    void RenderQueue::clear() {
+        // The storage belongs to the frame it was allocated in, so it is handed back rather than cleared; the next
+        // begin then allocates from its own frame. Assigning {} would only clear in place and keep the old storage.
+        decltype(mRecords)().swap(mRecords);
+        decltype(mEntries)().swap(mEntries);
+        decltype(mScratch)().swap(mScratch);
+        decltype(mShaderIds)().swap(mShaderIds);
+        decltype(mTextureIds)().swap(mTextureIds);
+        decltype(mVertexArrayIds)().swap(mVertexArrayIds);
+        decltype(mRetained)().swap(mRetained);
+    }
+}
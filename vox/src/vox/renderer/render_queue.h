@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "vox/core/frame_allocator.h"
+#include "vox/renderer/shader.h"
+#include "vox/renderer/texture.h"
+#include "vox/renderer/vertex_array.h"
+
+namespace Vox {
+    enum class SortMode {
+        // Order by layer, then shader, texture and vertex array so state changes are minimised
+        State,
+        // Keep submission order within each layer, for translucent geometry
+        Stable,
+    };
+
+    // Per-scene list of draws. Each draw gets a 64-bit sort key and the keys are radix sorted before execution:
+    //   State:  layer:8 | shader:12 | texture:16 | vertex array:16 | depth:12
+    //   Stable: layer:8 | 0 (the sort is stable, so submission order is kept)
+    //
+    // All storage comes from the FrameAllocator, so a queue must be executed within the frame it was begun in, or
+    // the next one when it is handed to the render thread.
+    class RenderQueue {
+    public:
+        // Plain handles, so records are copied and sorted without touching reference counts
+        struct DrawRecord {
+            ShaderHandle shader;
+            VertexArrayHandle vertexArray;
+            // Invalid for none
+            TextureHandle texture;
+            glm::mat4 transform;
+            // 0 for a plain indexed draw
+            uint32_t instanceCount;
+        };
+
+        // viewProjection is the camera the scene was begun with; the draws are executed with it
+        void begin(SortMode mode, const glm::mat4 &viewProjection);
+        void push(DrawRecord &&record, uint8_t layer);
+        // Keeps resource alive until the queue is cleared or destroyed, which is after it has been executed
+        void retain(const std::shared_ptr<const void> &resource);
+        void sort();
+        void clear();
+
+        const glm::mat4 &getViewProjection() const { return mViewProjection; }
+
+        size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+
+        // Records in sorted order once sort() has run
+        const DrawRecord &operator[](const size_t i) const { return mRecords[mEntries[i].index]; }
+
+    private:
+        struct SortEntry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        using IdMap = FrameUnorderedMap<uint32_t, uint32_t>;
+
+        static uint32_t intern(IdMap &ids, uint32_t handle);
+
+        SortMode mMode = SortMode::State;
+        glm::mat4 mViewProjection = glm::mat4(1.0f);
+        FrameVector<DrawRecord> mRecords;
+        FrameVector<SortEntry> mEntries;
+        FrameVector<SortEntry> mScratch;
+        // Size of the last queue sorted, reserved up front so the vectors rarely regrow
+        size_t mExpectedSize = 0;
+
+        IdMap mShaderIds;
+        IdMap mTextureIds;
+        IdMap mVertexArrayIds;
+
+        // Keyed by address, so a resource drawn many times is only retained once
+        FrameUnorderedMap<const void *, std::shared_ptr<const void>> mRetained;
+    };
+}
@@ -0,0 +1,196 @@
+#include "vox/renderer/render_thread.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "vox/window.h"
+
+namespace Vox {
+    static std::thread sThread;
+    static std::atomic<bool> sActive = false;
+    static thread_local bool tIsRenderThread = false;
+    static Window *sWindow = nullptr;
+
+    // Frame f is recorded into list f & 1
+    static std::array<RenderCommandList, 2> sLists;
+    // Written only by the update thread
+    static std::atomic<uint64_t> sSubmittedFrames = 0;
+    // Written only by the render thread
+    static std::atomic<uint64_t> sCompletedFrames = 0;
+
+    // Bumped whenever the render thread has something new to look at: a frame, a call or the request to stop
+    static std::atomic<uint32_t> sWake = 0;
+    static std::atomic<bool> sStopping = false;
+
+    // One call at a time; the render thread clears the slot once it has run
+    static std::mutex sCallMutex;
+    static std::atomic<const std::function<void()> *> sCall = nullptr;
+
+    // First exception a recorded command threw, rethrown on the update thread
+    static std::mutex sErrorMutex;
+    static std::exception_ptr sError;
+
+    static void Wake() {
+        sWake.fetch_add(1, std::memory_order_release);
+        sWake.notify_one();
+    }
+
+    static void RethrowError() {
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(sErrorMutex);
+            error = std::exchange(sError, nullptr);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    static void RenderLoop() {
+        tIsRenderThread = true;
+        sWindow->getGraphicsContext()->makeCurrent();
+
+        uint64_t executed = 0;
+        while (true) {
+            const uint32_t wake = sWake.load(std::memory_order_acquire);
+
+            if (const auto *call = sCall.load(std::memory_order_acquire)) {
+                (*call)();
+                sCall.store(nullptr, std::memory_order_release);
+                sCall.notify_all();
+                continue;
+            }
+
+            if (executed < sSubmittedFrames.load(std::memory_order_acquire)) {
+                try {
+                    sLists[executed & 1].execute();
+                } catch (...) {
+                    std::lock_guard lock(sErrorMutex);
+                    if (!sError) {
+                        sError = std::current_exception();
+                    }
+                }
+                executed++;
+                sCompletedFrames.store(executed, std::memory_order_release);
+                sCompletedFrames.notify_all();
+                continue;
+            }
+
+            if (sStopping.load(std::memory_order_acquire)) {
+                break;
+            }
+            sWake.wait(wake, std::memory_order_acquire);
+        }
+
+        sWindow->getGraphicsContext()->releaseCurrent();
+    }
+
+    // Hands the recording list over and waits until the list the next frame records into is free again
+    static void Publish() {
+        const uint64_t frame = sSubmittedFrames.load(std::memory_order_relaxed);
+        sSubmittedFrames.store(frame + 1, std::memory_order_release);
+        Wake();
+
+        // Frame + 1 reuses the list of frame - 1
+        uint64_t completed = sCompletedFrames.load(std::memory_order_acquire);
+        while (completed < frame) {
+            sCompletedFrames.wait(completed, std::memory_order_acquire);
+            completed = sCompletedFrames.load(std::memory_order_acquire);
+        }
+    }
+
+    void RenderThread::start(Window &window) {
+        if (isActive()) {
+            throw std::runtime_error("Render thread is already running!");
+        }
+
+        sWindow = &window;
+        sSubmittedFrames.store(0, std::memory_order_relaxed);
+        sCompletedFrames.store(0, std::memory_order_relaxed);
+        sStopping.store(false, std::memory_order_relaxed);
+
+        // A context can only be current on one thread at a time
+        window.getGraphicsContext()->releaseCurrent();
+        sThread = std::thread(RenderLoop);
+        sActive.store(true, std::memory_order_release);
+    }
+
+    void RenderThread::stop() {
+        if (!isActive()) {
+            return;
+        }
+
+        const uint64_t frame = sSubmittedFrames.load(std::memory_order_relaxed);
+        if (!sLists[frame & 1].empty()) {
+            Publish();
+        }
+        sStopping.store(true, std::memory_order_release);
+        Wake();
+        sThread.join();
+
+        sActive.store(false, std::memory_order_release);
+        sWindow->getGraphicsContext()->makeCurrent();
+        sWindow = nullptr;
+
+        RethrowError();
+    }
+
+    bool RenderThread::isActive() {
+        return sActive.load(std::memory_order_acquire);
+    }
+
+    bool RenderThread::isRenderThread() {
+        return tIsRenderThread;
+    }
+
+    void *RenderThread::allocate(const size_t size, const size_t alignment) {
+        return getRecordingList().allocate(size, alignment);
+    }
+
+    void RenderThread::endFrame() {
+        if (!isRecording()) {
+            return;
+        }
+
+        Window *window = sWindow;
+        getRecordingList().record([window] { window->swapBuffers(); });
+        Publish();
+
+        RethrowError();
+    }
+
+    RenderCommandList &RenderThread::getRecordingList() {
+        return sLists[sSubmittedFrames.load(std::memory_order_relaxed) & 1];
+    }
+
+    void RenderThread::invoke(const std::function<void()> &function) {
+        std::exception_ptr error;
+        const std::function<void()> call = [&function, &error] {
+            try {
+                function();
+            } catch (...) {
+                error = std::current_exception();
+            }
+        };
+
+        {
+            std::lock_guard lock(sCallMutex);
+            sCall.store(&call, std::memory_order_release);
+            Wake();
+            const std::function<void()> *pending = &call;
+            while (pending) {
+                sCall.wait(pending, std::memory_order_acquire);
+                pending = sCall.load(std::memory_order_acquire);
+            }
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
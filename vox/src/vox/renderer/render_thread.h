@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "vox/renderer/render_command_list.h"
+
+namespace Vox {
+    class Window;
+
+    // Optional thread that owns the graphics context. While it runs, the update thread (the one that called start)
+    // records its GL work into a command list per frame and hands the list over in endFrame; the render thread runs
+    // frame N while the update thread records frame N + 1. The handoff is two frame counters with a single writer
+    // each, so neither side takes a lock. Window events are still polled by the update thread.
+    //
+    // Renderer, Renderer2D and RenderCommand record through submit, resource factories run through call and resource
+    // destructors defer their deletes, so applications only going through those need no changes. Anything else that
+    // touches the context from the update thread while the render thread is active has to go through submit too.
+    class RenderThread {
+    public:
+        // The calling thread becomes the update thread and gives up the window's context
+        static void start(Window &window);
+        // Runs everything still recorded, joins the render thread and makes the context current here again
+        static void stop();
+
+        static bool isActive();
+        static bool isRenderThread();
+        // True when GL work issued from the calling thread has to be recorded rather than run
+        static bool isRecording() { return isActive() && !isRenderThread(); }
+
+        // Records command into the current frame, or runs it immediately when nothing needs recording. Only the
+        // update thread may record.
+        template<typename F>
+        static void submit(F &&command) {
+            if (isRecording()) {
+                getRecordingList().record(std::forward<F>(command));
+            } else {
+                command();
+            }
+        }
+
+        // Per-frame storage for data a recorded command points at, valid until the command has run. Only meaningful
+        // while isRecording.
+        static void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        // Runs function on the render thread between frames and waits for it, returning its result and rethrowing
+        // what it throws. This is how resources are created while the render thread is active. Runs function
+        // directly when nothing needs recording.
+        template<typename F>
+        static auto call(F &&function) -> std::invoke_result_t<F> {
+            using Result = std::invoke_result_t<F>;
+            if (!isRecording()) {
+                return function();
+            }
+            if constexpr (std::is_void_v<Result>) {
+                invoke([&function] { function(); });
+            } else {
+                std::optional<Result> result;
+                invoke([&function, &result] { result.emplace(function()); });
+                return std::move(*result);
+            }
+        }
+
+        // Records the buffer swap and hands the frame to the render thread. Blocks while the render thread is still
+        // on the frame before, so the update thread is never more than one frame ahead. Rethrows the first exception
+        // a recorded command threw.
+        static void endFrame();
+
+    private:
+        static RenderCommandList &getRecordingList();
+        static void invoke(const std::function<void()> &function);
+    };
+}
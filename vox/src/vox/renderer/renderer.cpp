@@ -1,28 +1,186 @@
 #include "vox/renderer/renderer.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "vox/renderer/render_thread.h"
+#include "vox/renderer/renderer_2d.h"
+
 #include "platform/opengl/shader.h"
 
 namespace Vox {
+    static constexpr UniformId sTransformId("u_transform");
+    static bool sSceneDataUploaded = false;
+
+    // Caps a single multi-draw so its commands and transforms stay well inside one streaming buffer region
+    static constexpr size_t sMaxMultiDrawCount = 4096;
+    static std::vector<RendererAPI::DrawIndexedIndirectCommand> sMultiDrawCommands;
+    static std::vector<glm::mat4> sMultiDrawTransforms;
+
     Renderer::SceneData *Renderer::sSceneData = new SceneData;
+    std::shared_ptr<UniformBuffer> Renderer::sSceneUniformBuffer;
+    RenderQueue *Renderer::sRenderQueue = new RenderQueue;
 
     void Renderer::init() {
         RenderCommand::init();
+        sSceneUniformBuffer = UniformBuffer::create(sizeof(SceneData), UniformBlockBinding::Scene);
+        sSceneDataUploaded = false;
+        Renderer2D::init();
+    }
+
+    void Renderer::shutdown() {
+        Renderer2D::shutdown();
+        sRenderQueue->clear();
+        sSceneUniformBuffer.reset();
+        RenderCommand::shutdown();
+    }
+
+    void Renderer::beginFrame() {
+        RenderCommand::beginFrame();
+        // Uniform buffer contents only live for one frame
+        sSceneDataUploaded = false;
     }
 
-    void Renderer::beginScene(const OrthographicCamera &camera) {
-        sSceneData->viewProjectionMatrix = camera.getViewProjectionMatrix();
+    void Renderer::endFrame() {
+        RenderCommand::endFrame();
+    }
+
+    void Renderer::beginScene(const OrthographicCamera &camera, const SortMode sortMode) {
+        setViewProjection(camera.getViewProjectionMatrix());
+        sRenderQueue->begin(sortMode, camera.getViewProjectionMatrix());
+    }
+
+    void Renderer::setViewProjection(const glm::mat4 &viewProjection) {
+        if (sSceneDataUploaded && sSceneData->viewProjectionMatrix == viewProjection) {
+            return;
+        }
+        sSceneData->viewProjectionMatrix = viewProjection;
+        RenderThread::submit([sceneData = *sSceneData] {
+            sSceneUniformBuffer->setData(&sceneData, sizeof(SceneData));
+        });
+        sSceneDataUploaded = true;
     }
 
     void Renderer::endScene() {
+        sRenderQueue->sort();
+        // Another scene, such as a Renderer2D one, may have published its own camera since beginScene
+        setViewProjection(sRenderQueue->getViewProjection());
+
+        if (!RenderThread::isRecording()) {
+            execute(*sRenderQueue);
+            sRenderQueue->clear();
+            return;
+        }
+
+        // The queue's storage lives in the frame allocator, so handing it to the render thread only moves pointers
+        RenderThread::submit([queue = std::move(*sRenderQueue)] { execute(queue); });
+        sRenderQueue->clear();
+    }
+
+    void Renderer::execute(const RenderQueue &queue) {
+        // Handles are resolved only when they change between records. The state cache drops redundant binds too, but
+        // skipping here also saves the virtual calls.
+        ShaderHandle boundShaderHandle;
+        VertexArrayHandle boundVertexArrayHandle;
+        TextureHandle boundTextureHandle;
+        Shader *shader = nullptr;
+        VertexArray *vertexArray = nullptr;
+        Texture *texture = nullptr;
+        for (size_t i = 0; i < queue.size();) {
+            const auto &record = queue[i];
+
+            if (record.shader != boundShaderHandle) {
+                boundShaderHandle = record.shader;
+                shader = Shader::resolve(record.shader);
+                if (shader) {
+                    shader->bind();
+                }
+            }
+            if (record.texture && record.texture != boundTextureHandle) {
+                boundTextureHandle = record.texture;
+                texture = Texture::resolve(record.texture);
+                if (texture) {
+                    texture->bind(0);
+                }
+            }
+            if (record.vertexArray != boundVertexArrayHandle) {
+                boundVertexArrayHandle = record.vertexArray;
+                vertexArray = VertexArray::resolve(record.vertexArray);
+                if (vertexArray) {
+                    vertexArray->bind();
+                }
+            }
+
+            // Something was destroyed after being submitted
+            if (!shader || !vertexArray || (record.texture && !texture)) {
+                i++;
+                continue;
+            }
+
+            if (shader->supportsMultiDraw()) {
+                i = executeMultiDraw(queue, i, *vertexArray);
+                continue;
+            }
+
+            if (record.instanceCount > 0) {
+                RenderCommand::drawIndexedInstanced(record.vertexArray, record.instanceCount);
+            } else {
+                shader->setMat4(sTransformId, record.transform);
+                RenderCommand::drawIndexed(record.vertexArray);
+            }
+            i++;
+        }
+    }
+
+    size_t Renderer::executeMultiDraw(const RenderQueue &queue, const size_t first, const VertexArray &vertexArray) {
+        const auto &firstRecord = queue[first];
+        const uint32_t indexCount = vertexArray.getIndexBuffer()->getCount();
+
+        // Sorting places draws that share shader, texture and vertex array next to each other
+        sMultiDrawCommands.clear();
+        sMultiDrawTransforms.clear();
+        size_t i = first;
+        for (; i < queue.size() && i - first < sMaxMultiDrawCount; i++) {
+            const auto &record = queue[i];
+            if (record.shader != firstRecord.shader || record.vertexArray != firstRecord.vertexArray ||
+                record.texture != firstRecord.texture) {
+                break;
+            }
+            sMultiDrawCommands.push_back({ indexCount, std::max(record.instanceCount, 1u), 0, 0, 0 });
+            sMultiDrawTransforms.push_back(record.transform);
+        }
+
+        RenderCommand::multiDrawIndexed(firstRecord.vertexArray, sMultiDrawCommands.data(),
+                                        sMultiDrawTransforms.data(), static_cast<uint32_t>(sMultiDrawCommands.size()));
+        return i;
+    }
+
+    void Renderer::submit(const ShaderHandle shader, const VertexArrayHandle vertexArray, const glm::mat4 &transform,
+                          const TextureHandle texture, const uint8_t layer) {
+        sRenderQueue->push({ shader, vertexArray, texture, transform, 0 }, layer);
+    }
+
+    void Renderer::submitInstanced(const ShaderHandle shader, const VertexArrayHandle vertexArray,
+                                   const uint32_t instanceCount, const TextureHandle texture, const uint8_t layer) {
+        sRenderQueue->push({ shader, vertexArray, texture, glm::mat4(1.0f), instanceCount }, layer);
     }
 
     void Renderer::submit(const std::shared_ptr<Shader> &shader, const std::shared_ptr<VertexArray> &vertexArray,
-                          const glm::mat4 &transform) {
-        shader->bind();
-        shader->setMat4("u_viewProjection", sSceneData->viewProjectionMatrix);
-        shader->setMat4("u_transform", transform);
+                          const glm::mat4 &transform, const std::shared_ptr<Texture> &texture, const uint8_t layer) {
+        sRenderQueue->retain(shader);
+        sRenderQueue->retain(vertexArray);
+        sRenderQueue->retain(texture);
+        submit(shader->getHandle(), vertexArray->getHandle(), transform, texture ? texture->getHandle() : TextureHandle(),
+               layer);
+    }
 
-        vertexArray->bind();
-        RenderCommand::drawIndexed(vertexArray);
+    void Renderer::submitInstanced(const std::shared_ptr<Shader> &shader,
+                                   const std::shared_ptr<VertexArray> &vertexArray, const uint32_t instanceCount,
+                                   const std::shared_ptr<Texture> &texture, const uint8_t layer) {
+        sRenderQueue->retain(shader);
+        sRenderQueue->retain(vertexArray);
+        sRenderQueue->retain(texture);
+        submitInstanced(shader->getHandle(), vertexArray->getHandle(), instanceCount,
+                        texture ? texture->getHandle() : TextureHandle(), layer);
     }
 }
@@ -2,26 +2,63 @@
 
 #include "vox/renderer/orthographic_camera.h"
 #include "vox/renderer/render_command.h"
+#include "vox/renderer/render_queue.h"
 #include "vox/renderer/shader.h"
+#include "vox/renderer/uniform_buffer.h"
 
 namespace Vox {
     class Renderer {
     public:
         static void init();
+        static void shutdown();
 
-        static void beginScene(const OrthographicCamera &camera);
+        static void beginFrame();
+        static void endFrame();
+
+        // Draws submitted between beginScene and endScene are queued, sorted according to sortMode and executed by
+        // endScene with this scene's camera, whatever scenes were begun in between.
+        static void beginScene(const OrthographicCamera &camera, SortMode sortMode = SortMode::State);
         static void endScene();
 
+        // Publishes the Scene uniform block shared by every shader. Called by beginScene and again before a queued
+        // scene executes; re-uploading an unchanged matrix within a frame is skipped, so Renderer2D can call it too
+        // without paying twice.
+        static void setViewProjection(const glm::mat4 &viewProjection);
+
+        // The texture, if any, is bound to slot 0. Layers are drawn in ascending order. Consecutive draws of a shader
+        // that supports multi-draw are collapsed into a single API call when the context allows it. Draws are queued
+        // by handle; any whose resources are destroyed before endScene are skipped.
+        static void submit(ShaderHandle shader, VertexArrayHandle vertexArray,
+                           const glm::mat4 &transform = glm::mat4(1.0f), TextureHandle texture = {}, uint8_t layer = 0);
+        // Draws instanceCount copies of vertexArray; per-instance data comes from its instanced vertex buffers.
+        static void submitInstanced(ShaderHandle shader, VertexArrayHandle vertexArray, uint32_t instanceCount,
+                                    TextureHandle texture = {}, uint8_t layer = 0);
+
+        // As above, but the queue also holds a reference to each resource until it has executed, so they may be
+        // released straight after submitting
         static void submit(const std::shared_ptr<Shader> &shader, const std::shared_ptr<VertexArray> &vertexArray,
-                           const glm::mat4 &transform = glm::mat4(1.0f));
+                           const glm::mat4 &transform = glm::mat4(1.0f),
+                           const std::shared_ptr<Texture> &texture = nullptr, uint8_t layer = 0);
+        static void submitInstanced(const std::shared_ptr<Shader> &shader,
+                                    const std::shared_ptr<VertexArray> &vertexArray, uint32_t instanceCount,
+                                    const std::shared_ptr<Texture> &texture = nullptr, uint8_t layer = 0);
 
         static RendererAPI::API getAPI() { return RendererAPI::getAPI(); }
 
     private:
+        // Binds and draws a sorted queue
+        static void execute(const RenderQueue &queue);
+        // Draws the run of queue entries starting at first that share its shader, texture and vertex array with one
+        // multi-draw. Returns the index of the first entry not drawn.
+        static size_t executeMultiDraw(const RenderQueue &queue, size_t first, const VertexArray &vertexArray);
+
+        // std140 layout of the Scene block, see UniformBlockBinding::Scene
         struct SceneData {
             glm::mat4 viewProjectionMatrix;
         };
 
         static SceneData *sSceneData;
+        static std::shared_ptr<UniformBuffer> sSceneUniformBuffer;
+        static RenderQueue *sRenderQueue;
     };
 }
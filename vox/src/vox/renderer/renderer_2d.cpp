@@ -0,0 +1,321 @@
+#include "vox/renderer/renderer_2d.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "vox/renderer/render_command.h"
+#include "vox/renderer/render_thread.h"
+#include "vox/renderer/renderer.h"
+#include "vox/renderer/shader.h"
+#include "vox/renderer/vertex_array.h"
+
+namespace Vox {
+    // Embedded into the engine at build time, so it never touches the file system
+    static constexpr const char *sQuadShaderPath = "vox/shaders/renderer_2d_quad.glsl";
+
+    static constexpr UniformId sTexturesId("u_textures");
+    static constexpr UniformId sTextureArraysId("u_textureArrays");
+
+    struct QuadVertex {
+        glm::vec3 position;
+        glm::vec4 color;
+        glm::vec2 texCoord;
+        float texIndex;
+        float texLayer;
+    };
+
+    struct Renderer2DData {
+        // OpenGL 3.3 guarantees 16 fragment texture units. The first 12 hold 2D textures, with slot 0 reserved for
+        // the white texture, and the rest hold texture arrays.
+        static constexpr uint32_t maxQuads = 10000;
+        static constexpr uint32_t maxVertices = maxQuads * 4;
+        static constexpr uint32_t maxIndices = maxQuads * 6;
+        static constexpr uint32_t maxTextureSlots = 12;
+        static constexpr uint32_t maxTextureArraySlots = 4;
+
+        std::shared_ptr<VertexArray> quadVertexArray;
+        std::shared_ptr<VertexBuffer> quadVertexBuffer;
+        std::shared_ptr<Shader> quadShader;
+        std::shared_ptr<Texture2D> whiteTexture;
+
+        // Camera of the current scene, re-published by every flush
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+
+        uint32_t quadIndexCount = 0;
+        QuadVertex *quadVertexBufferBase = nullptr;
+        QuadVertex *quadVertexBufferPtr = nullptr;
+
+        // Handles, so batches are copied into recorded flushes without touching reference counts
+        std::array<TextureHandle, maxTextureSlots> textureSlots;
+        uint32_t textureSlotIndex = 1;
+        std::array<TextureHandle, maxTextureArraySlots> textureArraySlots;
+        uint32_t textureArraySlotIndex = 0;
+
+        Renderer2D::Statistics stats;
+    };
+
+    static const glm::vec2 sQuadCorners[4] = {
+        { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f }
+    };
+    static const glm::vec2 sQuadTexCoords[4] = {
+        { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }
+    };
+    static const TextureRegion sFullRegion;
+
+    static Renderer2DData *sData = nullptr;
+
+    void Renderer2D::init() {
+        sData = new Renderer2DData;
+
+        sData->quadVertexArray = VertexArray::create();
+
+        sData->quadVertexBuffer = VertexBuffer::create(Renderer2DData::maxVertices * sizeof(QuadVertex),
+                                                       BufferUsage::Stream);
+        sData->quadVertexBuffer->setLayout({
+            { ShaderDataType::Float3, "a_position" },
+            { ShaderDataType::Float4, "a_color" },
+            { ShaderDataType::Float2, "a_texCoord" },
+            { ShaderDataType::Float, "a_texIndex" },
+            { ShaderDataType::Float, "a_texLayer" }
+        });
+        sData->quadVertexArray->addVertexBuffer(sData->quadVertexBuffer);
+
+        sData->quadVertexBufferBase = new QuadVertex[Renderer2DData::maxVertices];
+
+        // Every quad uses the same index pattern, so the index buffer is built once and never touched again
+        static_assert(Renderer2DData::maxVertices <= 0x10000, "Quad indices must fit in 16 bits");
+        auto *quadIndices = new uint16_t[Renderer2DData::maxIndices];
+        uint16_t offset = 0;
+        for (uint32_t i = 0; i < Renderer2DData::maxIndices; i += 6) {
+            quadIndices[i + 0] = static_cast<uint16_t>(offset + 0);
+            quadIndices[i + 1] = static_cast<uint16_t>(offset + 1);
+            quadIndices[i + 2] = static_cast<uint16_t>(offset + 2);
+
+            quadIndices[i + 3] = static_cast<uint16_t>(offset + 2);
+            quadIndices[i + 4] = static_cast<uint16_t>(offset + 3);
+            quadIndices[i + 5] = static_cast<uint16_t>(offset + 0);
+
+            offset = static_cast<uint16_t>(offset + 4);
+        }
+        sData->quadVertexArray->setIndexBuffer(IndexBuffer::create(quadIndices, Renderer2DData::maxIndices,
+                                                                   IndexType::UInt16));
+        delete[] quadIndices;
+
+        sData->whiteTexture = Texture2D::create(1, 1);
+        uint32_t whiteTextureData = 0xffffffff;
+        sData->whiteTexture->setData(&whiteTextureData, sizeof(uint32_t));
+
+        int samplers[Renderer2DData::maxTextureSlots + Renderer2DData::maxTextureArraySlots];
+        for (uint32_t i = 0; i < Renderer2DData::maxTextureSlots + Renderer2DData::maxTextureArraySlots; i++) {
+            samplers[i] = static_cast<int>(i);
+        }
+
+        sData->quadShader = Shader::create(sQuadShaderPath);
+        sData->quadShader->bind();
+        sData->quadShader->setIntArray(sTexturesId, samplers, Renderer2DData::maxTextureSlots);
+        sData->quadShader->setIntArray(sTextureArraysId, samplers + Renderer2DData::maxTextureSlots,
+                                       Renderer2DData::maxTextureArraySlots);
+
+        sData->textureSlots[0] = sData->whiteTexture->getHandle();
+    }
+
+    void Renderer2D::shutdown() {
+        delete[] sData->quadVertexBufferBase;
+        delete sData;
+        sData = nullptr;
+    }
+
+    void Renderer2D::beginScene(const OrthographicCamera &camera) {
+        sData->viewProjection = camera.getViewProjectionMatrix();
+        Renderer::setViewProjection(sData->viewProjection);
+
+        startBatch();
+    }
+
+    void Renderer2D::endScene() {
+        flush();
+    }
+
+    void Renderer2D::startBatch() {
+        sData->quadIndexCount = 0;
+        sData->quadVertexBufferPtr = sData->quadVertexBufferBase;
+        sData->textureSlotIndex = 1;
+        sData->textureArraySlotIndex = 0;
+    }
+
+    void Renderer2D::flush() {
+        if (sData->quadIndexCount == 0) {
+            return;
+        }
+
+        // A Renderer scene ended since beginScene may have published its own camera
+        Renderer::setViewProjection(sData->viewProjection);
+
+        const auto dataSize = static_cast<uint32_t>(reinterpret_cast<uint8_t *>(sData->quadVertexBufferPtr) -
+                                                    reinterpret_cast<uint8_t *>(sData->quadVertexBufferBase));
+        // The batch is refilled before a recorded flush runs, so the vertices are copied into frame storage
+        const void *vertices = sData->quadVertexBufferBase;
+        if (RenderThread::isRecording()) {
+            void *copy = RenderThread::allocate(dataSize, alignof(QuadVertex));
+            std::memcpy(copy, vertices, dataSize);
+            vertices = copy;
+        }
+
+        RenderThread::submit([vertices, dataSize, indexCount = sData->quadIndexCount,
+                              textures = sData->textureSlots, textureCount = sData->textureSlotIndex,
+                              textureArrays = sData->textureArraySlots,
+                              textureArrayCount = sData->textureArraySlotIndex] {
+            sData->quadVertexBuffer->setData(vertices, dataSize);
+
+            // A texture destroyed since it was drawn is replaced by the white one; the unit would otherwise still hold
+            // whatever was bound to it last. Array slots have no stand-in, so such a batch is skipped.
+            for (uint32_t i = 0; i < textureCount; i++) {
+                const Texture *texture = Texture::resolve(textures[i]);
+                (texture ? texture : sData->whiteTexture.get())->bind(i);
+            }
+            for (uint32_t i = 0; i < textureArrayCount; i++) {
+                const Texture *texture = Texture::resolve(textureArrays[i]);
+                if (!texture) {
+                    return;
+                }
+                texture->bind(Renderer2DData::maxTextureSlots + i);
+            }
+
+            sData->quadShader->bind();
+            sData->quadVertexArray->bind();
+            RenderCommand::drawIndexed(sData->quadVertexArray, indexCount);
+        });
+        sData->stats.drawCalls++;
+    }
+
+    void Renderer2D::nextBatch() {
+        flush();
+        startBatch();
+    }
+
+    float Renderer2D::getTextureIndex(const std::shared_ptr<Texture2D> &texture) {
+        for (uint32_t i = 1; i < sData->textureSlotIndex; i++) {
+            if (sData->textureSlots[i] == texture->getHandle()) {
+                return static_cast<float>(i);
+            }
+        }
+
+        if (sData->textureSlotIndex >= Renderer2DData::maxTextureSlots) {
+            nextBatch();
+        }
+
+        const uint32_t index = sData->textureSlotIndex++;
+        sData->textureSlots[index] = texture->getHandle();
+        return static_cast<float>(index);
+    }
+
+    float Renderer2D::getTextureArrayIndex(const std::shared_ptr<Texture2DArray> &texture) {
+        for (uint32_t i = 0; i < sData->textureArraySlotIndex; i++) {
+            if (sData->textureArraySlots[i] == texture->getHandle()) {
+                return static_cast<float>(Renderer2DData::maxTextureSlots + i);
+            }
+        }
+
+        if (sData->textureArraySlotIndex >= Renderer2DData::maxTextureArraySlots) {
+            nextBatch();
+        }
+
+        const uint32_t index = sData->textureArraySlotIndex++;
+        sData->textureArraySlots[index] = texture->getHandle();
+        return static_cast<float>(Renderer2DData::maxTextureSlots + index);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color) {
+        drawQuad({ position.x, position.y, 0.0f }, size, color);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color) {
+        drawQuad(position, size, 0.0f, nullptr, color);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const float rotation,
+                              const std::shared_ptr<Texture2D> &texture, const glm::vec4 &tint) {
+        if (sData->quadIndexCount >= Renderer2DData::maxIndices) {
+            nextBatch();
+        }
+
+        const float textureIndex = texture ? getTextureIndex(texture) : 0.0f;
+        writeQuad(position, size, rotation, textureIndex, sFullRegion, tint);
+    }
+
+    void Renderer2D::drawQuad(const glm::vec3 &position, const glm::vec2 &size, const float rotation,
+                              const std::shared_ptr<Texture2DArray> &texture, const TextureRegion &region,
+                              const glm::vec4 &tint) {
+        if (sData->quadIndexCount >= Renderer2DData::maxIndices) {
+            nextBatch();
+        }
+
+        writeQuad(position, size, rotation, getTextureArrayIndex(texture), region, tint);
+    }
+
+    void Renderer2D::drawQuad(const glm::mat4 &transform, const std::shared_ptr<Texture2D> &texture,
+                              const glm::vec4 &tint) {
+        if (sData->quadIndexCount >= Renderer2DData::maxIndices) {
+            nextBatch();
+        }
+
+        const float textureIndex = texture ? getTextureIndex(texture) : 0.0f;
+        writeQuad(transform, textureIndex, sFullRegion, tint);
+    }
+
+    void Renderer2D::drawQuad(const glm::mat4 &transform, const std::shared_ptr<Texture2DArray> &texture,
+                              const TextureRegion &region, const glm::vec4 &tint) {
+        if (sData->quadIndexCount >= Renderer2DData::maxIndices) {
+            nextBatch();
+        }
+
+        writeQuad(transform, getTextureArrayIndex(texture), region, tint);
+    }
+
+    void Renderer2D::writeQuad(const glm::vec3 &position, const glm::vec2 &size, const float rotation,
+                               const float textureIndex, const TextureRegion &region, const glm::vec4 &tint) {
+        // Expand the quad corners directly rather than building a mat4 per quad
+        const float radians = glm::radians(rotation);
+        const float c = std::cos(radians);
+        const float s = std::sin(radians);
+        const float layer = static_cast<float>(region.layer);
+        for (uint32_t i = 0; i < 4; i++) {
+            const float x = sQuadCorners[i].x * size.x;
+            const float y = sQuadCorners[i].y * size.y;
+            sData->quadVertexBufferPtr->position = { position.x + x * c - y * s, position.y + x * s + y * c, position.z };
+            sData->quadVertexBufferPtr->color = tint;
+            sData->quadVertexBufferPtr->texCoord = region.uvMin + (region.uvMax - region.uvMin) * sQuadTexCoords[i];
+            sData->quadVertexBufferPtr->texIndex = textureIndex;
+            sData->quadVertexBufferPtr->texLayer = layer;
+            sData->quadVertexBufferPtr++;
+        }
+
+        sData->quadIndexCount += 6;
+        sData->stats.quadCount++;
+    }
+
+    void Renderer2D::writeQuad(const glm::mat4 &transform, const float textureIndex, const TextureRegion &region,
+                               const glm::vec4 &tint) {
+        const float layer = static_cast<float>(region.layer);
+        for (uint32_t i = 0; i < 4; i++) {
+            sData->quadVertexBufferPtr->position = glm::vec3(transform * glm::vec4(sQuadCorners[i], 0.0f, 1.0f));
+            sData->quadVertexBufferPtr->color = tint;
+            sData->quadVertexBufferPtr->texCoord = region.uvMin + (region.uvMax - region.uvMin) * sQuadTexCoords[i];
+            sData->quadVertexBufferPtr->texIndex = textureIndex;
+            sData->quadVertexBufferPtr->texLayer = layer;
+            sData->quadVertexBufferPtr++;
+        }
+
+        sData->quadIndexCount += 6;
+        sData->stats.quadCount++;
+    }
+
+    const Renderer2D::Statistics &Renderer2D::getStats() {
+        return sData->stats;
+    }
+
+    void Renderer2D::resetStats() {
+        sData->stats = Statistics();
+    }
+}
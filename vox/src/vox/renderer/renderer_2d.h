@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+
+#include <glm/glm.hpp>
+
+#include "vox/renderer/orthographic_camera.h"
+#include "vox/renderer/texture.h"
+#include "vox/renderer/texture_atlas.h"
+
+namespace Vox {
+    // Batched quad renderer. Quads are written into a CPU-side vertex buffer and flushed in as few draw calls as
+    // possible; a batch is only broken when it runs out of vertices or texture slots. Sprites packed into a
+    // TextureAtlas share a single texture array slot however many images they use.
+    class Renderer2D {
+    public:
+        static void init();
+        static void shutdown();
+
+        static void beginScene(const OrthographicCamera &camera);
+        static void endScene();
+        static void flush();
+
+        // Rotation is in degrees, matching OrthographicCamera.
+        static void drawQuad(const glm::vec2 &position, const glm::vec2 &size, const glm::vec4 &color);
+        static void drawQuad(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color);
+        static void drawQuad(const glm::vec3 &position, const glm::vec2 &size, float rotation,
+                             const std::shared_ptr<Texture2D> &texture, const glm::vec4 &tint = glm::vec4(1.0f));
+        static void drawQuad(const glm::mat4 &transform, const std::shared_ptr<Texture2D> &texture,
+                             const glm::vec4 &tint = glm::vec4(1.0f));
+        // Draws a region of one layer, usually from TextureAtlas::getRegion
+        static void drawQuad(const glm::vec3 &position, const glm::vec2 &size, float rotation,
+                             const std::shared_ptr<Texture2DArray> &texture, const TextureRegion &region,
+                             const glm::vec4 &tint = glm::vec4(1.0f));
+        static void drawQuad(const glm::mat4 &transform, const std::shared_ptr<Texture2DArray> &texture,
+                             const TextureRegion &region, const glm::vec4 &tint = glm::vec4(1.0f));
+
+        struct Statistics {
+            uint32_t drawCalls = 0;
+            uint32_t quadCount = 0;
+
+            uint32_t getTotalVertexCount() const { return quadCount * 4; }
+            uint32_t getTotalIndexCount() const { return quadCount * 6; }
+        };
+
+        static const Statistics &getStats();
+        static void resetStats();
+
+    private:
+        static void startBatch();
+        static void nextBatch();
+        static float getTextureIndex(const std::shared_ptr<Texture2D> &texture);
+        static float getTextureArrayIndex(const std::shared_ptr<Texture2DArray> &texture);
+        static void writeQuad(const glm::vec3 &position, const glm::vec2 &size, float rotation, float textureIndex,
+                              const TextureRegion &region, const glm::vec4 &tint);
+        static void writeQuad(const glm::mat4 &transform, float textureIndex, const TextureRegion &region,
+                              const glm::vec4 &tint);
+    };
+}
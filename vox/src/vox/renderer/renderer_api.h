@@ -14,12 +14,43 @@ namespace Vox {
             OpenGL = 1,
         };
 
+        struct FrameStatistics {
+            uint32_t stateChanges = 0;
+            uint32_t stateChangesElided = 0;
+        };
+
+        // Detected by init()
+        struct Capabilities {
+            bool multiDrawIndirect = false;
+        };
+
+        // Same layout as the API's indexed indirect draw command
+        struct DrawIndexedIndirectCommand {
+            uint32_t indexCount;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
         virtual void init() = 0;
+        virtual void shutdown() = 0;
+
+        virtual void beginFrame() = 0;
+        virtual void endFrame() = 0;
+        // Counters for the last completed frame
+        virtual FrameStatistics getFrameStatistics() const = 0;
+        virtual const Capabilities &getCapabilities() const = 0;
 
         virtual void setClearColor(const glm::vec4 &color) = 0;
         virtual void clear() = 0;
 
-        virtual void drawIndexed(const std::shared_ptr<VertexArray> &vertexArray) = 0;
+        virtual void drawIndexed(const VertexArray &vertexArray, uint32_t indexCount) = 0;
+        virtual void drawIndexedInstanced(const VertexArray &vertexArray, uint32_t instanceCount) = 0;
+        // Issues drawCount draws of vertexArray in a single call. Draw i reads transforms[i] from the DrawData block.
+        // Requires Capabilities::multiDrawIndirect.
+        virtual void multiDrawIndexed(const VertexArray &vertexArray, const DrawIndexedIndirectCommand *commands,
+                                      const glm::mat4 *transforms, uint32_t drawCount) = 0;
 
         static API getAPI() {
             return API::OpenGL;
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "vox/renderer/render_thread.h"
+
+namespace Vox {
+    template<typename T, typename Stored>
+    class ResourcePool;
+
+    // 32-bit reference to a pooled resource: a 20-bit slot index and a 12-bit generation. The generation changes
+    // whenever a slot is released, so a handle to a destroyed resource resolves to nullptr rather than to whatever
+    // took the slot over (until the generation wraps, 4095 reuses later). A default constructed handle is never valid.
+    template<typename T>
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool isValid() const { return mValue != 0; }
+        explicit operator bool() const { return isValid(); }
+
+        uint32_t getIndex() const { return mValue & IndexMask; }
+        uint32_t getGeneration() const { return mValue >> IndexBits; }
+        uint32_t getValue() const { return mValue; }
+
+        bool operator==(const Handle &) const = default;
+
+        static constexpr uint32_t IndexBits = 20;
+        static constexpr uint32_t IndexMask = (1u << IndexBits) - 1;
+        static constexpr uint32_t MaxGeneration = (1u << (32 - IndexBits)) - 1;
+
+    private:
+        template<typename, typename>
+        friend class ResourcePool;
+
+        Handle(const uint32_t index, const uint32_t generation) : mValue(generation << IndexBits | index) {
+        }
+
+        uint32_t mValue = 0;
+    };
+
+    // Dense slot array mapping handles to resources. Stored is what the slots hold, T or a base of it. Only touched on
+    // the thread that owns the graphics context, which is where resources are created, destroyed and drawn.
+    template<typename T, typename Stored = T>
+    class ResourcePool {
+    public:
+        Handle<T> add(Stored *resource) {
+            uint32_t index;
+            if (mFreeSlots.empty()) {
+                index = static_cast<uint32_t>(mResources.size());
+                if (index > Handle<T>::IndexMask) {
+                    throw std::runtime_error("Resource pool is full!");
+                }
+                mResources.push_back(resource);
+                mGenerations.push_back(1);
+            } else {
+                index = mFreeSlots.back();
+                mFreeSlots.pop_back();
+                mResources[index] = resource;
+            }
+            return { index, mGenerations[index] };
+        }
+
+        void release(const Handle<T> handle) {
+            if (!contains(handle)) {
+                return;
+            }
+            const uint32_t index = handle.getIndex();
+            mResources[index] = nullptr;
+            // Generation 0 is skipped, so no live handle is ever 0
+            mGenerations[index] = mGenerations[index] == Handle<T>::MaxGeneration ? 1 : mGenerations[index] + 1;
+            mFreeSlots.push_back(index);
+        }
+
+        // nullptr for a stale or invalid handle
+        Stored *get(const Handle<T> handle) const {
+            return contains(handle) ? mResources[handle.getIndex()] : nullptr;
+        }
+
+        bool contains(const Handle<T> handle) const {
+            const uint32_t index = handle.getIndex();
+            return handle.isValid() && index < mResources.size() && mGenerations[index] == handle.getGeneration();
+        }
+
+        size_t size() const { return mResources.size() - mFreeSlots.size(); }
+
+    private:
+        std::vector<Stored *> mResources;
+        std::vector<uint32_t> mGenerations;
+        std::vector<uint32_t> mFreeSlots;
+    };
+
+    // Base for resources that can be referred to by Handle<T>. A resource takes a slot in T's pool when constructed
+    // and gives it back when destroyed, both on the thread that owns the graphics context.
+    template<typename T>
+    class PooledResource {
+    public:
+        Handle<T> getHandle() const { return mHandle; }
+
+        // nullptr once the resource has been destroyed
+        static T *resolve(const Handle<T> handle) { return static_cast<T *>(sPool.get(handle)); }
+
+        // Shares ownership of a new resource. The last reference going away defers deletion to the render thread,
+        // behind every command already recorded, so handles taken from it stay valid for everything submitted
+        // before then.
+        template<typename U>
+        static std::shared_ptr<U> makeShared(U *resource) {
+            return std::shared_ptr<U>(resource, [](U *released) {
+                RenderThread::submit([released] { delete released; });
+            });
+        }
+
+    protected:
+        PooledResource() : mHandle(sPool.add(this)) {
+        }
+
+        ~PooledResource() {
+            sPool.release(mHandle);
+        }
+
+        PooledResource(const PooledResource &) = delete;
+        PooledResource &operator=(const PooledResource &) = delete;
+
+    private:
+        Handle<T> mHandle;
+
+        // Holds the base, as the resource is not a T yet while this is constructed
+        inline static ResourcePool<T, PooledResource> sPool;
+    };
+}
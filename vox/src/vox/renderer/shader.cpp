@@ -1,5 +1,6 @@
 #include "vox/renderer/shader.h"
 
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 #include "platform/opengl/shader.h"
@@ -10,7 +11,18 @@ namespace Vox {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is currently not supported!");
             case RendererAPI::API::OpenGL:
-                return std::make_shared<OpenGLShader>(filepath);
+                return RenderThread::call([&] { return makeShared<Shader>(new OpenGLShader(filepath)); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<Shader> Shader::createAsync(const std::string &filepath) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is currently not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return makeShared<Shader>(new OpenGLShader(filepath, true)); });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
@@ -21,7 +33,9 @@ namespace Vox {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is currently not supported!");
             case RendererAPI::API::OpenGL:
-                return std::make_shared<OpenGLShader>(name, vertexSrc, fragmentSrc);
+                return RenderThread::call([&] {
+                    return makeShared<Shader>(new OpenGLShader(name, vertexSrc, fragmentSrc));
+                });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
@@ -51,6 +65,17 @@ namespace Vox {
         return shader;
     }
 
+    std::vector<std::shared_ptr<Shader>> ShaderLibrary::loadAsync(const std::vector<std::string> &filepaths) {
+        std::vector<std::shared_ptr<Shader>> shaders;
+        shaders.reserve(filepaths.size());
+        for (const auto &filepath : filepaths) {
+            auto shader = Shader::createAsync(filepath);
+            add(shader);
+            shaders.push_back(shader);
+        }
+        return shaders;
+    }
+
     std::shared_ptr<Shader> ShaderLibrary::get(const std::string &name) {
         if (!exists(name)) {
             throw std::runtime_error("Shader not found!");
@@ -61,4 +86,13 @@ namespace Vox {
     bool ShaderLibrary::exists(const std::string &name) const {
         return mShaders.contains(name);
     }
+
+    bool ShaderLibrary::isReady() const {
+        for (const auto &[name, shader] : mShaders) {
+            if (!shader->isReady()) {
+                return false;
+            }
+        }
+        return true;
+    }
 }
@@ -1,12 +1,45 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
+#include "vox/renderer/resource_pool.h"
+
 namespace Vox {
-    class Shader {
+    // Pre-hashed uniform name. Declare these as constexpr so hot loops never hash or compare strings:
+    //   static constexpr UniformId sTransform("u_transform");
+    class UniformId {
+    public:
+        constexpr explicit UniformId(const std::string_view name) : mHash(hash(name)) {
+        }
+
+        constexpr uint32_t getHash() const { return mHash; }
+
+        constexpr bool operator==(const UniformId &) const = default;
+
+        // 32-bit FNV-1a
+        static constexpr uint32_t hash(const std::string_view name) {
+            uint32_t hash = 2166136261u;
+            for (const char c : name) {
+                hash ^= static_cast<uint8_t>(c);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+    private:
+        uint32_t mHash;
+    };
+
+    class Shader;
+    using ShaderHandle = Handle<Shader>;
+
+    class Shader : public PooledResource<Shader> {
     public:
         virtual ~Shader() = default;
 
@@ -15,7 +48,16 @@ namespace Vox {
 
         virtual const std::string &getName() const = 0;
 
+        // True when the shader reads its transform from the per-draw DrawData block (see "#pragma vox draw_data" in
+        // OpenGLShader) and can be drawn with RenderCommand::multiDrawIndexed
+        virtual bool supportsMultiDraw() const = 0;
+
+        // False while a shader made with createAsync is still compiling in the background. Never blocks; binding a
+        // shader that is not ready waits for it. Drivers without parallel compile support always report true.
+        virtual bool isReady() const = 0;
+
         virtual void setInt(const std::string &name, int value) = 0;
+        virtual void setIntArray(const std::string &name, const int *values, uint32_t count) = 0;
         virtual void setFloat(const std::string &name, float value) = 0;
         virtual void setFloat2(const std::string &name, const glm::vec2 &value) = 0;
         virtual void setFloat3(const std::string &name, const glm::vec3 &value) = 0;
@@ -23,7 +65,18 @@ namespace Vox {
         virtual void setMat3(const std::string &name, const glm::mat3 &matrix) = 0;
         virtual void setMat4(const std::string &name, const glm::mat4 &matrix) = 0;
 
+        virtual void setInt(UniformId id, int value) = 0;
+        virtual void setIntArray(UniformId id, const int *values, uint32_t count) = 0;
+        virtual void setFloat(UniformId id, float value) = 0;
+        virtual void setFloat2(UniformId id, const glm::vec2 &value) = 0;
+        virtual void setFloat3(UniformId id, const glm::vec3 &value) = 0;
+        virtual void setFloat4(UniformId id, const glm::vec4 &value) = 0;
+        virtual void setMat3(UniformId id, const glm::mat3 &matrix) = 0;
+        virtual void setMat4(UniformId id, const glm::mat4 &matrix) = 0;
+
         static std::shared_ptr<Shader> create(const std::string &filepath);
+        // Issues the compile without waiting for it. Errors are thrown from the first bind instead.
+        static std::shared_ptr<Shader> createAsync(const std::string &filepath);
         static std::shared_ptr<Shader> create(const std::string &name, const std::string &vertexSrc,
                                               const std::string &fragmentSrc);
     };
@@ -34,10 +87,14 @@ namespace Vox {
         void add(const std::shared_ptr<Shader> &shader);
         std::shared_ptr<Shader> load(const std::string &filepath);
         std::shared_ptr<Shader> load(const std::string &name, const std::string &filepath);
+        // Issues every compile before waiting on any of them, so the driver can work on them all at once
+        std::vector<std::shared_ptr<Shader>> loadAsync(const std::vector<std::string> &filepaths);
 
         std::shared_ptr<Shader> get(const std::string &name);
 
         bool exists(const std::string &name) const;
+        // True once every shader in the library has finished compiling
+        bool isReady() const;
 
     private:
         std::unordered_map<std::string, std::shared_ptr<Shader>> mShaders;
@@ -1,16 +1,55 @@
 #include "vox/renderer/texture.h"
 
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 #include "platform/opengl/texture.h"
 
 namespace Vox {
-    std::shared_ptr<Texture2D> Texture2D::create(const std::string &path) {
+    std::shared_ptr<Texture2D> Texture2D::create(const uint32_t width, const uint32_t height, const TextureSpec &spec) {
         switch (Renderer::getAPI()) {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is not supported!");
             case RendererAPI::API::OpenGL:
-                return std::make_shared<OpenGLTexture2D>(path);
+                return RenderThread::call([&] {
+                    return makeShared<Texture2D>(new OpenGLTexture2D(width, height, spec));
+                });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<Texture2D> Texture2D::create(const std::string &path, const TextureSpec &spec) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return makeShared<Texture2D>(new OpenGLTexture2D(path, spec)); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<Texture2D> Texture2D::createAsync(const std::string &path, const TextureSpec &spec) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return OpenGLTexture2D::createAsync(path, spec); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+
+    std::shared_ptr<Texture2DArray> Texture2DArray::create(const uint32_t width, const uint32_t height,
+                                                           const uint32_t layers, const TextureSpec &spec) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] {
+                    return makeShared<Texture2DArray>(new OpenGLTexture2DArray(width, height, layers, spec));
+                });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
@@ -2,20 +2,83 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+
+#include "vox/renderer/resource_pool.h"
 
 namespace Vox {
-    class Texture {
+    enum class TextureFilter {
+        Nearest, Linear
+    };
+
+    enum class TextureWrap {
+        Repeat, MirroredRepeat, ClampToEdge
+    };
+
+    struct TextureSpec {
+        // With mips, minFilter also selects between levels, so Linear is trilinear filtering
+        TextureFilter minFilter = TextureFilter::Linear;
+        TextureFilter magFilter = TextureFilter::Nearest;
+        TextureWrap wrap = TextureWrap::Repeat;
+        // Build the full mip chain on upload. Minified textures then sample a level close to their on-screen size
+        // instead of striding across level 0.
+        bool generateMips = true;
+        // Caps a generated mip chain, 0 for no limit. Atlases use this to stop sampling before neighbouring
+        // sub-textures bleed into each other.
+        uint32_t maxMipLevels = 0;
+        // Clamped to what the device supports; 1 disables anisotropic filtering
+        float maxAnisotropy = 8.0f;
+        // Store colour data as sRGB so sampling returns linear values
+        bool sRGB = false;
+        // Multiply colour by alpha on import, for blending with GL_ONE, GL_ONE_MINUS_SRC_ALPHA. Source images only;
+        // cooked containers are premultiplied by vox-texcook.
+        bool premultiplyAlpha = false;
+        // Upload 3 channel images as RGBA8. Drivers pad RGB8 to 4 bytes per texel anyway and usually convert on the
+        // CPU to do it.
+        bool expandRGB = true;
+    };
+
+    class Texture;
+    using TextureHandle = Handle<Texture>;
+
+    class Texture : public PooledResource<Texture> {
     public:
         virtual ~Texture() = default;
 
         virtual uint32_t getWidth() const = 0;
         virtual uint32_t getHeight() const = 0;
+        virtual const TextureSpec &getSpec() const = 0;
+        // False while an asynchronously loaded texture is still showing its placeholder
+        virtual bool isReady() const = 0;
+        // Approximate video memory used by every mip level
+        virtual uint64_t getMemorySize() const = 0;
+
+        // Replaces level 0; the mip chain is regenerated if the spec asks for one
+        virtual void setData(void *data, uint32_t size) = 0;
 
         virtual void bind(uint32_t slot) const = 0;
     };
 
     class Texture2D : public Texture {
     public:
-        static std::shared_ptr<Texture2D> create(const std::string &path);
+        static std::shared_ptr<Texture2D> create(uint32_t width, uint32_t height, const TextureSpec &spec = {});
+        static std::shared_ptr<Texture2D> create(const std::string &path, const TextureSpec &spec = {});
+        // Returns a 1x1 white placeholder straight away. The image is decoded on a worker thread and uploaded over
+        // the following frames, after which the same handle shows it and isReady() becomes true. A file that cannot be
+        // loaded is reported on stderr and leaves the placeholder in place.
+        static std::shared_ptr<Texture2D> createAsync(const std::string &path, const TextureSpec &spec = {});
+    };
+
+    // Stack of equally sized RGBA8 layers sampled as one texture, so draws using different layers can share a
+    // batch. expandRGB does not apply; layer data is always RGBA8.
+    class Texture2DArray : public Texture {
+    public:
+        virtual uint32_t getLayerCount() const = 0;
+
+        // Replaces level 0 of a single layer. setData replaces every layer at once.
+        virtual void setLayerData(uint32_t layer, const void *data, uint32_t size) = 0;
+
+        static std::shared_ptr<Texture2DArray> create(uint32_t width, uint32_t height, uint32_t layers,
+                                                      const TextureSpec &spec = {});
     };
 }
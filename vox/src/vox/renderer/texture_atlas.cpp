@@ -0,0 +1,215 @@
+#include "vox/renderer/texture_atlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "vox/image/image_ops.h"
+#include "vox/renderer/texture_container.h"
+#include "vox/vfs/vfs.h"
+
+namespace Vox {
+    TextureAtlas::TextureAtlas(const TextureAtlasSpec &spec) : mSpec(spec) {
+        if (spec.pageSize == 0) {
+            throw std::runtime_error("Texture atlas page size must not be zero!");
+        }
+
+        // Level k is clean while a level k texel (2^k texels at level 0) fits in the gutter
+        mMipLevels = 1;
+        while ((2u << (mMipLevels - 1)) <= spec.padding) {
+            mMipLevels++;
+        }
+        mCellSize = 1u << (mMipLevels - 1);
+
+        mSpec.textureSpec.wrap = TextureWrap::ClampToEdge;
+        if (mSpec.textureSpec.generateMips) {
+            const uint32_t maxLevels = mSpec.textureSpec.maxMipLevels;
+            mSpec.textureSpec.maxMipLevels = maxLevels ? std::min(maxLevels, mMipLevels) : mMipLevels;
+        }
+    }
+
+    void TextureAtlas::add(const std::string &name, const std::string &path) {
+        const VFSFile file = VFS::read(path);
+        const auto bytes = file.getData();
+        if (TextureContainer::isContainer(bytes)) {
+            const auto container = TextureContainer::load(bytes, path);
+            const auto pixels = container.decodeLevel(0);
+            add(name, container.getWidth(), container.getHeight(), pixels.data());
+            return;
+        }
+
+        ImageOps::DecodeOptions options;
+        options.premultiplyAlpha = mSpec.textureSpec.premultiplyAlpha;
+        const auto image = ImageOps::decode(bytes, options);
+        add(name, image.width, image.height, image.pixels.data());
+    }
+
+    void TextureAtlas::add(const std::string &name, const uint32_t width, const uint32_t height, const void *pixels) {
+        if (mTexture) {
+            throw std::runtime_error("Texture atlas has already been built!");
+        }
+        if (mRegions.contains(name) ||
+            std::any_of(mQueued.begin(), mQueued.end(), [&](const Image &image) { return image.name == name; })) {
+            throw std::runtime_error("Texture atlas already contains '" + name + "'!");
+        }
+        if (width == 0 || height == 0) {
+            throw std::runtime_error("Texture atlas images must not be empty!");
+        }
+
+        Image image{ name, width, height, {} };
+        const auto *begin = static_cast<const uint8_t *>(pixels);
+        image.pixels.assign(begin, begin + static_cast<size_t>(width) * height * 4);
+        mQueued.push_back(std::move(image));
+    }
+
+    void TextureAtlas::build() {
+        if (mTexture) {
+            throw std::runtime_error("Texture atlas has already been built!");
+        }
+
+        // Tallest first keeps the skyline flat, which wastes far less space than insertion order
+        std::stable_sort(mQueued.begin(), mQueued.end(), [](const Image &a, const Image &b) {
+            return a.height != b.height ? a.height > b.height : a.width > b.width;
+        });
+
+        const uint32_t pageCells = mSpec.pageSize / mCellSize;
+        struct Placement {
+            uint32_t page, x, y;
+        };
+        std::vector<Placement> placements;
+        placements.reserve(mQueued.size());
+        for (const auto &image : mQueued) {
+            const uint32_t width = (image.width + mSpec.padding * 2 + mCellSize - 1) / mCellSize;
+            const uint32_t height = (image.height + mSpec.padding * 2 + mCellSize - 1) / mCellSize;
+            if (width > pageCells || height > pageCells) {
+                throw std::runtime_error("'" + image.name + "' does not fit in a texture atlas page!");
+            }
+
+            Placement placement{};
+            bool placed = false;
+            for (uint32_t i = 0; i < mPages.size() && !placed; i++) {
+                placement.page = i;
+                placed = insert(mPages[i], width, height, placement.x, placement.y);
+            }
+            if (!placed) {
+                placement.page = static_cast<uint32_t>(mPages.size());
+                mPages.push_back({ { { 0, 0, pageCells } } });
+                insert(mPages.back(), width, height, placement.x, placement.y);
+            }
+            placements.push_back(placement);
+        }
+        if (mPages.empty()) {
+            mPages.push_back({ { { 0, 0, pageCells } } });
+        }
+
+        const size_t pageBytes = static_cast<size_t>(mSpec.pageSize) * mSpec.pageSize * 4;
+        std::vector<uint8_t> pixels(pageBytes * mPages.size());
+        const float pageSize = static_cast<float>(mSpec.pageSize);
+        for (size_t i = 0; i < mQueued.size(); i++) {
+            const auto &image = mQueued[i];
+            const auto &placement = placements[i];
+            const uint32_t originX = placement.x * mCellSize;
+            const uint32_t originY = placement.y * mCellSize;
+            const uint32_t paddedWidth = (image.width + mSpec.padding * 2 + mCellSize - 1) / mCellSize * mCellSize;
+            const uint32_t paddedHeight = (image.height + mSpec.padding * 2 + mCellSize - 1) / mCellSize * mCellSize;
+
+            // The gutter repeats the edge texels, clamping each destination texel back into the image
+            uint8_t *page = pixels.data() + pageBytes * placement.page;
+            for (uint32_t y = 0; y < paddedHeight; y++) {
+                const uint32_t sourceY = std::min(static_cast<uint32_t>(std::max(
+                    static_cast<int64_t>(y) - mSpec.padding, int64_t(0))), image.height - 1);
+                uint8_t *row = page + (static_cast<size_t>(originY + y) * mSpec.pageSize + originX) * 4;
+                const uint8_t *sourceRow = image.pixels.data() + static_cast<size_t>(sourceY) * image.width * 4;
+                for (uint32_t x = 0; x < paddedWidth; x++) {
+                    const uint32_t sourceX = std::min(static_cast<uint32_t>(std::max(
+                        static_cast<int64_t>(x) - mSpec.padding, int64_t(0))), image.width - 1);
+                    std::memcpy(row + static_cast<size_t>(x) * 4, sourceRow + static_cast<size_t>(sourceX) * 4, 4);
+                }
+            }
+
+            TextureRegion region;
+            region.uvMin = glm::vec2(originX + mSpec.padding, originY + mSpec.padding) / pageSize;
+            region.uvMax = glm::vec2(originX + mSpec.padding + image.width,
+                                     originY + mSpec.padding + image.height) / pageSize;
+            region.layer = placement.page;
+            mRegions[image.name] = region;
+        }
+
+        mTexture = Texture2DArray::create(mSpec.pageSize, mSpec.pageSize, static_cast<uint32_t>(mPages.size()),
+                                          mSpec.textureSpec);
+        mTexture->setData(pixels.data(), static_cast<uint32_t>(pixels.size()));
+
+        mQueued.clear();
+        mQueued.shrink_to_fit();
+    }
+
+    bool TextureAtlas::contains(const std::string &name) const {
+        return mRegions.contains(name);
+    }
+
+    const TextureRegion &TextureAtlas::getRegion(const std::string &name) const {
+        const auto it = mRegions.find(name);
+        if (it == mRegions.end()) {
+            throw std::runtime_error("Texture atlas does not contain '" + name + "'!");
+        }
+        return it->second;
+    }
+
+    // Skyline bottom-left: rests the rectangle on the skyline wherever its top ends up lowest, leftmost on ties.
+    // Sizes and positions are in cells.
+    bool TextureAtlas::insert(Page &page, const uint32_t width, const uint32_t height, uint32_t &x,
+                              uint32_t &y) const {
+        const uint32_t pageCells = mSpec.pageSize / mCellSize;
+        auto &skyline = page.skyline;
+
+        size_t bestIndex = skyline.size();
+        uint32_t bestY = UINT32_MAX;
+        for (size_t i = 0; i < skyline.size(); i++) {
+            const uint32_t left = skyline[i].x;
+            if (left + width > pageCells) {
+                break;
+            }
+
+            // The rectangle rests on the highest segment it spans
+            uint32_t top = 0;
+            for (size_t j = i; j < skyline.size() && skyline[j].x < left + width; j++) {
+                top = std::max(top, skyline[j].y);
+            }
+            if (top + height <= pageCells && top < bestY) {
+                bestIndex = i;
+                bestY = top;
+            }
+        }
+        if (bestIndex == skyline.size()) {
+            return false;
+        }
+
+        x = skyline[bestIndex].x;
+        y = bestY;
+
+        // Replace the covered span with the rectangle's top edge, trimming a partially covered segment
+        const uint32_t right = x + width;
+        size_t end = bestIndex;
+        while (end < skyline.size() && skyline[end].x + skyline[end].width <= right) {
+            end++;
+        }
+        if (end < skyline.size() && skyline[end].x < right) {
+            skyline[end].width -= right - skyline[end].x;
+            skyline[end].x = right;
+        }
+        skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex),
+                      skyline.begin() + static_cast<std::ptrdiff_t>(end));
+        skyline.insert(skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), { x, y + height, width });
+
+        // Merge neighbours at the same height so later searches stay short
+        for (size_t i = 0; i + 1 < skyline.size();) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+            } else {
+                i++;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "vox/renderer/texture.h"
+
+namespace Vox {
+    // Part of a texture array layer, in normalised texture coordinates
+    struct TextureRegion {
+        glm::vec2 uvMin = glm::vec2(0.0f);
+        glm::vec2 uvMax = glm::vec2(1.0f);
+        uint32_t layer = 0;
+    };
+
+    struct TextureAtlasSpec {
+        uint32_t pageSize = 2048;
+        // Gutter around each image, filled by repeating its edge texels. Mips are capped at the level where a texel
+        // still fits inside the gutter, so 4 keeps three levels free of bleeding from neighbours.
+        uint32_t padding = 4;
+        // Applied to the page array. wrap is always ClampToEdge, since regions do not repeat anyway.
+        TextureSpec textureSpec;
+    };
+
+    // Packs many small images into the pages of a single Texture2DArray at load time, so sprites with different
+    // images can be drawn in one batch. Images are queued with add() and packed by build() with a skyline
+    // bottom-left packer, tallest first.
+    class TextureAtlas {
+    public:
+        explicit TextureAtlas(const TextureAtlasSpec &spec = {});
+
+        // Decoded through the VFS. Cooked containers contribute their full size level.
+        void add(const std::string &name, const std::string &path);
+        // RGBA8 pixels, rows bottom-up like every other texture upload
+        void add(const std::string &name, uint32_t width, uint32_t height, const void *pixels);
+
+        // Packs every queued image and uploads the pages. Images cannot be added afterwards.
+        void build();
+
+        bool contains(const std::string &name) const;
+        const TextureRegion &getRegion(const std::string &name) const;
+        const std::shared_ptr<Texture2DArray> &getTexture() const { return mTexture; }
+        uint32_t getPageCount() const { return static_cast<uint32_t>(mPages.size()); }
+
+    private:
+        struct Image {
+            std::string name;
+            uint32_t width, height;
+            std::vector<uint8_t> pixels;
+        };
+
+        // Top edge of the packed area, as horizontal segments from left to right
+        struct SkylineSegment {
+            uint32_t x, y, width;
+        };
+
+        struct Page {
+            std::vector<SkylineSegment> skyline;
+        };
+
+        bool insert(Page &page, uint32_t width, uint32_t height, uint32_t &x, uint32_t &y) const;
+
+        TextureAtlasSpec mSpec;
+        // Packing happens in cells of this many texels, so every padded image starts on a texel of each usable mip
+        uint32_t mCellSize;
+        uint32_t mMipLevels;
+
+        std::vector<Image> mQueued;
+        std::vector<Page> mPages;
+        std::unordered_map<std::string, TextureRegion> mRegions;
+        std::shared_ptr<Texture2DArray> mTexture;
+    };
+}
@@ -0,0 +1,228 @@
+#include "vox/renderer/texture_container.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace Vox {
+    static void DecodeColor565(const uint16_t color, uint8_t *rgba) {
+        const uint32_t r = (color >> 11) & 0x1f;
+        const uint32_t g = (color >> 5) & 0x3f;
+        const uint32_t b = color & 0x1f;
+        rgba[0] = static_cast<uint8_t>((r << 3) | (r >> 2));
+        rgba[1] = static_cast<uint8_t>((g << 2) | (g >> 4));
+        rgba[2] = static_cast<uint8_t>((b << 3) | (b >> 2));
+        rgba[3] = 255;
+    }
+
+    // Writes the 16 texels of a BC1 colour block as RGBA. BC3 colour blocks always use the four colour mode.
+    static void DecodeColorBlock(const uint8_t *block, uint8_t texels[16][4], const bool forceFourColors) {
+        const uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+        const uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+
+        uint8_t palette[4][4];
+        DecodeColor565(c0, palette[0]);
+        DecodeColor565(c1, palette[1]);
+        if (c0 > c1 || forceFourColors) {
+            for (int i = 0; i < 3; i++) {
+                palette[2][i] = static_cast<uint8_t>((2 * palette[0][i] + palette[1][i]) / 3);
+                palette[3][i] = static_cast<uint8_t>((palette[0][i] + 2 * palette[1][i]) / 3);
+            }
+            palette[2][3] = palette[3][3] = 255;
+        } else {
+            for (int i = 0; i < 3; i++) {
+                palette[2][i] = static_cast<uint8_t>((palette[0][i] + palette[1][i]) / 2);
+                palette[3][i] = 0;
+            }
+            palette[2][3] = 255;
+            palette[3][3] = 0;
+        }
+
+        const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+        for (int i = 0; i < 16; i++) {
+            std::memcpy(texels[i], palette[(indices >> (2 * i)) & 3], 4);
+        }
+    }
+
+    static void DecodeAlphaBlock(const uint8_t *block, uint8_t texels[16][4]) {
+        const uint32_t a0 = block[0];
+        const uint32_t a1 = block[1];
+
+        uint8_t palette[8];
+        palette[0] = static_cast<uint8_t>(a0);
+        palette[1] = static_cast<uint8_t>(a1);
+        if (a0 > a1) {
+            for (uint32_t i = 1; i < 7; i++) {
+                palette[i + 1] = static_cast<uint8_t>(((7 - i) * a0 + i * a1) / 7);
+            }
+        } else {
+            for (uint32_t i = 1; i < 5; i++) {
+                palette[i + 1] = static_cast<uint8_t>(((5 - i) * a0 + i * a1) / 5);
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (int i = 0; i < 6; i++) {
+            indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+        }
+        for (int i = 0; i < 16; i++) {
+            texels[i][3] = palette[(indices >> (3 * i)) & 7];
+        }
+    }
+
+    TextureContainer::TextureContainer(const TextureContainerFormat format, const uint32_t width,
+                                       const uint32_t height, const bool sRGB)
+        : mFormat(format), mWidth(width), mHeight(height), mSRGB(sRGB) {
+    }
+
+    bool TextureContainer::isContainer(const std::string &path) {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        uint32_t magic = 0;
+        return in.read(reinterpret_cast<char *>(&magic), sizeof(magic)) && magic == Magic;
+    }
+
+    bool TextureContainer::isContainer(const std::span<const uint8_t> data) {
+        uint32_t magic = 0;
+        if (data.size() < sizeof(magic)) {
+            return false;
+        }
+        std::memcpy(&magic, data.data(), sizeof(magic));
+        return magic == Magic;
+    }
+
+    TextureContainer TextureContainer::load(const std::string &path) {
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Could not open file '" + path + "'!");
+        }
+        in.seekg(0, std::ios::end);
+        std::vector<uint8_t> data(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        return load(data, path);
+    }
+
+    TextureContainer TextureContainer::load(const std::span<const uint8_t> data, const std::string &name) {
+        Header header{};
+        if (data.size() < sizeof(header)) {
+            throw std::runtime_error("'" + name + "' is not a texture container!");
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != Magic) {
+            throw std::runtime_error("'" + name + "' is not a texture container!");
+        }
+        if (header.version != Version) {
+            throw std::runtime_error("Unsupported texture container version in '" + name + "'!");
+        }
+        const uint64_t levelsEnd = sizeof(Header) + static_cast<uint64_t>(header.mipCount) * sizeof(Level);
+        if (header.mipCount == 0 || header.format > TextureContainerFormat::BC3 || levelsEnd > data.size()) {
+            throw std::runtime_error("Corrupt texture container '" + name + "'!");
+        }
+
+        std::vector<Level> levels(header.mipCount);
+        std::memcpy(levels.data(), data.data() + sizeof(Header), levels.size() * sizeof(Level));
+
+        TextureContainer container(header.format, header.width, header.height, header.flags & FlagSRGB);
+        // Level 0 matches the header and every further level halves it, as readers size their copies by them
+        uint32_t expectedWidth = header.width, expectedHeight = header.height;
+        for (const auto &level : levels) {
+            if (level.width != expectedWidth || level.height != expectedHeight || level.width == 0 ||
+                level.height == 0 || level.size != getLevelSize(header.format, level.width, level.height) ||
+                static_cast<uint64_t>(level.offset) + level.size > data.size()) {
+                throw std::runtime_error("Corrupt texture container '" + name + "'!");
+            }
+            container.addLevel(level.width, level.height, data.data() + level.offset, level.size);
+            expectedWidth = std::max(1u, level.width / 2);
+            expectedHeight = std::max(1u, level.height / 2);
+        }
+        return container;
+    }
+
+    void TextureContainer::save(const std::string &path) const {
+        std::ofstream out(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not open file '" + path + "' for writing!");
+        }
+
+        const Header header = {
+            Magic, Version, mFormat, mWidth, mHeight, getLevelCount(), mSRGB ? FlagSRGB : 0u, 0
+        };
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        const auto payloadOffset = static_cast<uint32_t>(sizeof(Header) + mLevels.size() * sizeof(Level));
+        for (Level level : mLevels) {
+            level.offset += payloadOffset;
+            out.write(reinterpret_cast<const char *>(&level), sizeof(level));
+        }
+        out.write(reinterpret_cast<const char *>(mData.data()), static_cast<std::streamsize>(mData.size()));
+        if (!out) {
+            throw std::runtime_error("Failed to write texture container '" + path + "'!");
+        }
+    }
+
+    void TextureContainer::addLevel(const uint32_t width, const uint32_t height, const void *data,
+                                    const uint32_t size) {
+        if (size != getLevelSize(mFormat, width, height)) {
+            throw std::runtime_error("Texture container level has the wrong size!");
+        }
+        mLevels.push_back({ width, height, static_cast<uint32_t>(mData.size()), size });
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        mData.insert(mData.end(), bytes, bytes + size);
+    }
+
+    std::vector<uint8_t> TextureContainer::decodeLevel(const uint32_t level) const {
+        const auto &info = mLevels[level];
+        const uint8_t *data = getLevelData(level);
+        if (mFormat == TextureContainerFormat::RGBA8) {
+            return { data, data + info.size };
+        }
+
+        std::vector<uint8_t> pixels(static_cast<size_t>(info.width) * info.height * 4);
+        const uint32_t blocksX = (info.width + 3) / 4;
+        const uint32_t blocksY = (info.height + 3) / 4;
+        const uint32_t blockSize = mFormat == TextureContainerFormat::BC1 ? 8 : 16;
+
+        uint8_t texels[16][4];
+        for (uint32_t by = 0; by < blocksY; by++) {
+            for (uint32_t bx = 0; bx < blocksX; bx++) {
+                const uint8_t *block = data + (by * blocksX + bx) * blockSize;
+                if (mFormat == TextureContainerFormat::BC1) {
+                    DecodeColorBlock(block, texels, false);
+                } else {
+                    DecodeColorBlock(block + 8, texels, true);
+                    DecodeAlphaBlock(block, texels);
+                }
+
+                // Edge blocks are padded; drop the texels that fall outside the level
+                for (uint32_t y = 0; y < 4 && by * 4 + y < info.height; y++) {
+                    for (uint32_t x = 0; x < 4 && bx * 4 + x < info.width; x++) {
+                        const size_t pixel = static_cast<size_t>(by * 4 + y) * info.width + bx * 4 + x;
+                        std::memcpy(&pixels[pixel * 4], texels[y * 4 + x], 4);
+                    }
+                }
+            }
+        }
+        return pixels;
+    }
+
+    bool TextureContainer::isBlockCompressed(const TextureContainerFormat format) {
+        return format == TextureContainerFormat::BC1 || format == TextureContainerFormat::BC3;
+    }
+
+    uint32_t TextureContainer::getLevelSize(const TextureContainerFormat format, const uint32_t width,
+                                            const uint32_t height) {
+        switch (format) {
+            case TextureContainerFormat::RGBA8:
+                return width * height * 4;
+            case TextureContainerFormat::BC1:
+                return std::max(1u, (width + 3) / 4) * std::max(1u, (height + 3) / 4) * 8;
+            case TextureContainerFormat::BC3:
+                return std::max(1u, (width + 3) / 4) * std::max(1u, (height + 3) / 4) * 16;
+            default:
+                throw std::runtime_error("Unknown TextureContainerFormat!");
+        }
+    }
+}
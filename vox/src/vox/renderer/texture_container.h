@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Vox {
+    enum class TextureContainerFormat : uint32_t {
+        RGBA8 = 0,
+        // 4x4 blocks of 8 bytes, opaque RGB
+        BC1 = 1,
+        // 4x4 blocks of 16 bytes, RGB plus interpolated alpha
+        BC3 = 2,
+    };
+
+    // Ready-to-upload texture written offline by vox-texcook (.vxt). Every mip level is stored in the format it is
+    // uploaded in, rows bottom-up to match OpenGL, so loading is a file read and one upload per level.
+    //
+    // File layout (little-endian):
+    //   Header
+    //   Level[mipCount]
+    //   level payloads, at Level::offset from the start of the file
+    class TextureContainer {
+    public:
+        static constexpr uint32_t Magic = 0x31545856; // "VXT1"
+        static constexpr uint32_t Version = 1;
+
+        enum Flags : uint32_t {
+            FlagSRGB = 1 << 0,
+        };
+
+        struct Header {
+            uint32_t magic;
+            uint32_t version;
+            TextureContainerFormat format;
+            uint32_t width;
+            uint32_t height;
+            uint32_t mipCount;
+            uint32_t flags;
+            uint32_t reserved;
+        };
+
+        struct Level {
+            uint32_t width;
+            uint32_t height;
+            uint32_t offset;
+            uint32_t size;
+        };
+
+        TextureContainer(TextureContainerFormat format, uint32_t width, uint32_t height, bool sRGB);
+
+        // Checks the magic only, so a container can be told apart from a source image without reading it all
+        static bool isContainer(const std::string &path);
+        static bool isContainer(std::span<const uint8_t> data);
+        static TextureContainer load(const std::string &path);
+        // name is only used in error messages
+        static TextureContainer load(std::span<const uint8_t> data, const std::string &name);
+        void save(const std::string &path) const;
+
+        // Levels must be added in order, starting with the full size image
+        void addLevel(uint32_t width, uint32_t height, const void *data, uint32_t size);
+
+        TextureContainerFormat getFormat() const { return mFormat; }
+        uint32_t getWidth() const { return mWidth; }
+        uint32_t getHeight() const { return mHeight; }
+        bool isSRGB() const { return mSRGB; }
+
+        uint32_t getLevelCount() const { return static_cast<uint32_t>(mLevels.size()); }
+        // Offset is relative to getLevelData
+        const Level &getLevel(const uint32_t level) const { return mLevels[level]; }
+        const uint8_t *getLevelData(const uint32_t level) const { return mData.data() + mLevels[level].offset; }
+
+        // RGBA8 pixels of a level, decoding block compressed formats. For devices without S3TC support.
+        std::vector<uint8_t> decodeLevel(uint32_t level) const;
+
+        static bool isBlockCompressed(TextureContainerFormat format);
+        static uint32_t getLevelSize(TextureContainerFormat format, uint32_t width, uint32_t height);
+
+    private:
+        TextureContainerFormat mFormat;
+        uint32_t mWidth, mHeight;
+        bool mSRGB;
+        std::vector<Level> mLevels;
+        std::vector<uint8_t> mData;
+    };
+}
@@ -0,0 +1,21 @@
+#include "vox/renderer/uniform_buffer.h"
+
+#include <stdexcept>
+
+#include "vox/renderer/render_thread.h"
+#include "vox/renderer/renderer.h"
+
+#include "platform/opengl/uniform_buffer.h"
+
+namespace Vox {
+    std::shared_ptr<UniformBuffer> UniformBuffer::create(uint32_t size, uint32_t binding) {
+        switch (Renderer::getAPI()) {
+            case RendererAPI::API::None:
+                throw std::runtime_error("RendererAPI::None is currently not supported!");
+            case RendererAPI::API::OpenGL:
+                return RenderThread::call([&] { return std::make_shared<OpenGLUniformBuffer>(size, binding); });
+            default:
+                throw std::runtime_error("Unknown RendererAPI!");
+        }
+    }
+}
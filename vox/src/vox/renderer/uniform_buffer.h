@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+namespace Vox {
+    // Well-known binding points. Shaders that declare a uniform block with the matching name are bound to these
+    // automatically when they are linked.
+    enum class UniformBlockBinding : uint32_t {
+        Scene = 0,
+    };
+
+    class UniformBuffer {
+    public:
+        virtual ~UniformBuffer() = default;
+
+        // Writes never stall on the GPU: every call publishes the whole block into fresh per-frame memory, so data
+        // still being read by frames in flight is left untouched. The block only stays valid until the end of the
+        // frame, so it has to be written again in every frame that uses it.
+        virtual void setData(const void *data, uint32_t size, uint32_t offset = 0) = 0;
+
+        virtual uint32_t getSize() const = 0;
+        virtual uint32_t getBinding() const = 0;
+
+        static std::shared_ptr<UniformBuffer> create(uint32_t size, uint32_t binding);
+        static std::shared_ptr<UniformBuffer> create(uint32_t size, UniformBlockBinding binding) {
+            return create(size, static_cast<uint32_t>(binding));
+        }
+    };
+}
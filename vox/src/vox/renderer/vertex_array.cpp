@@ -1,16 +1,17 @@
 #include "vox/renderer/vertex_array.h"
 
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 #include "platform/opengl/vertex_array.h"
 
 namespace Vox {
-    VertexArray* VertexArray::create() {
+    std::shared_ptr<VertexArray> VertexArray::create() {
         switch (Renderer::getAPI()) {
             case RendererAPI::API::None:
                 throw std::runtime_error("RendererAPI::None is currently not supported!");
             case RendererAPI::API::OpenGL:
-                return new OpenGLVertexArray();
+                return RenderThread::call([&] { return makeShared<VertexArray>(new OpenGLVertexArray()); });
             default:
                 throw std::runtime_error("Unknown RendererAPI!");
         }
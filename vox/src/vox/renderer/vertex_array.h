@@ -3,9 +3,13 @@
 #include <memory>
 
 #include "vox/renderer/buffer.h"
+#include "vox/renderer/resource_pool.h"
 
 namespace Vox {
-    class VertexArray {
+    class VertexArray;
+    using VertexArrayHandle = Handle<VertexArray>;
+
+    class VertexArray : public PooledResource<VertexArray> {
     public:
         virtual ~VertexArray() = default;
 
@@ -18,6 +22,6 @@ namespace Vox {
         virtual const std::vector<std::shared_ptr<VertexBuffer>> &getVertexBuffers() const = 0;
         virtual const std::shared_ptr<IndexBuffer> &getIndexBuffer() const = 0;
 
-        static VertexArray *create();
+        static std::shared_ptr<VertexArray> create();
     };
 }
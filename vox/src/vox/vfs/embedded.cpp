@@ -0,0 +1,41 @@
+#include "vox/vfs/embedded.h"
+
+#include <mutex>
+#include <unordered_map>
+
+// Generated from vox/assets; called here so the linker cannot drop it from the static library
+VOX_DECLARE_EMBEDDED_FILES(vox);
+
+namespace Vox {
+    struct EmbeddedRegistry {
+        EmbeddedRegistry() {
+            for (const auto &file : VoxEmbedded_vox()) {
+                files.insert_or_assign(file.path, &file);
+            }
+        }
+
+        std::mutex mutex;
+        std::unordered_map<std::string_view, const EmbeddedFile *> files;
+    };
+
+    // Constructed on first use, as generated tables may register during static initialisation
+    static EmbeddedRegistry &GetRegistry() {
+        static EmbeddedRegistry sRegistry;
+        return sRegistry;
+    }
+
+    void EmbeddedFiles::add(const std::span<const EmbeddedFile> files) {
+        auto &registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        for (const auto &file : files) {
+            registry.files.insert_or_assign(file.path, &file);
+        }
+    }
+
+    const EmbeddedFile *EmbeddedFiles::find(const std::string_view path) {
+        auto &registry = GetRegistry();
+        std::lock_guard lock(registry.mutex);
+        const auto it = registry.files.find(path);
+        return it == registry.files.end() ? nullptr : it->second;
+    }
+}
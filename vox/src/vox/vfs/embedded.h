@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Vox {
+    // A file compiled into the binary by vox_embed_resources (see vox/cmake/embed.cmake). The data lives in static
+    // storage and is followed by a terminating zero that is not counted in its size.
+    struct EmbeddedFile {
+        std::string_view path;
+        std::span<const uint8_t> data;
+    };
+
+    // Searches one generated table directly. Only needed by code that does not link the engine; everything else goes
+    // through EmbeddedFiles or the VFS.
+    inline const EmbeddedFile *FindEmbeddedFile(const std::span<const EmbeddedFile> files, const std::string_view path) {
+        for (const auto &file : files) {
+            if (file.path == path) {
+                return &file;
+            }
+        }
+        return nullptr;
+    }
+
+    // Process wide registry of embedded files, searched by the VFS before any archive or the disk. The engine's own
+    // files are always present; tables generated into an executable register themselves before main.
+    class EmbeddedFiles {
+    public:
+        // Later tables replace files with the same path, so a game can override an engine file
+        static void add(std::span<const EmbeddedFile> files);
+        // Paths are relative and use forward slashes, as the VFS normalises them
+        static const EmbeddedFile *find(std::string_view path);
+    };
+}
+
+// Declares the accessor generated for vox_embed_resources(... NAME <name> ...)
+#define VOX_DECLARE_EMBEDDED_FILES(name) std::span<const Vox::EmbeddedFile> VoxEmbedded_##name()
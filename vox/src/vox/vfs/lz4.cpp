@@ -0,0 +1,165 @@
+#include "vox/vfs/lz4.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Vox::LZ4 {
+    static constexpr size_t MinMatch = 4;
+    // The format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+    static constexpr size_t LastLiterals = 5;
+    static constexpr size_t MatchFindLimit = 12;
+    static constexpr size_t MaxOffset = 65535;
+    static constexpr uint32_t HashBits = 12;
+
+    static uint32_t Read32(const uint8_t *p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static uint32_t Hash(const uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HashBits);
+    }
+
+    // Writes the 255-run continuation of a length whose nibble was saturated
+    static bool WriteLength(size_t length, uint8_t *&op, const uint8_t *end) {
+        for (; length >= 255; length -= 255) {
+            if (op >= end) return false;
+            *op++ = 255;
+        }
+        if (op >= end) return false;
+        *op++ = static_cast<uint8_t>(length);
+        return true;
+    }
+
+    static bool WriteSequence(const uint8_t *literals, const size_t literalLength, const size_t offset,
+                              const size_t matchLength, uint8_t *&op, const uint8_t *end) {
+        if (op >= end) return false;
+        uint8_t *token = op++;
+        *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+        if (literalLength >= 15 && !WriteLength(literalLength - 15, op, end)) {
+            return false;
+        }
+        if (static_cast<size_t>(end - op) < literalLength) return false;
+        std::memcpy(op, literals, literalLength);
+        op += literalLength;
+
+        // The final sequence carries literals only
+        if (matchLength == 0) {
+            return true;
+        }
+
+        if (end - op < 2) return false;
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        const size_t length = matchLength - MinMatch;
+        *token |= static_cast<uint8_t>(std::min<size_t>(length, 15));
+        return length < 15 || WriteLength(length - 15, op, end);
+    }
+
+    size_t compress(const uint8_t *src, const size_t srcSize, uint8_t *dst, const size_t dstCapacity) {
+        uint8_t *op = dst;
+        const uint8_t *end = dst + dstCapacity;
+        size_t anchor = 0;
+
+        if (srcSize > MatchFindLimit) {
+            // Positions are stored plus one so zero means empty
+            uint32_t table[1 << HashBits] = {};
+            const size_t matchLimit = srcSize - LastLiterals;
+
+            size_t ip = 0;
+            while (ip + MatchFindLimit <= srcSize) {
+                const uint32_t sequence = Read32(src + ip);
+                uint32_t &slot = table[Hash(sequence)];
+                const size_t candidate = slot;
+                slot = static_cast<uint32_t>(ip + 1);
+
+                if (candidate == 0 || ip - (candidate - 1) > MaxOffset || Read32(src + candidate - 1) != sequence) {
+                    ip++;
+                    continue;
+                }
+
+                const size_t match = candidate - 1;
+                size_t length = MinMatch;
+                while (ip + length < matchLimit && src[match + length] == src[ip + length]) {
+                    length++;
+                }
+
+                if (!WriteSequence(src + anchor, ip - anchor, ip - match, length, op, end)) {
+                    return 0;
+                }
+                ip += length;
+                anchor = ip;
+            }
+        }
+
+        if (!WriteSequence(src + anchor, srcSize - anchor, 0, 0, op, end)) {
+            return 0;
+        }
+        return static_cast<size_t>(op - dst);
+    }
+
+    static bool ReadLength(size_t &length, const uint8_t *&ip, const uint8_t *end) {
+        uint8_t byte;
+        do {
+            if (ip >= end) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    bool decompress(const uint8_t *src, const size_t srcSize, uint8_t *dst, const size_t dstSize) {
+        const uint8_t *ip = src;
+        const uint8_t *const ipEnd = src + srcSize;
+        uint8_t *op = dst;
+        uint8_t *const opEnd = dst + dstSize;
+
+        while (ip < ipEnd) {
+            const uint8_t token = *ip++;
+
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !ReadLength(literalLength, ip, ipEnd)) {
+                return false;
+            }
+            if (static_cast<size_t>(ipEnd - ip) < literalLength || static_cast<size_t>(opEnd - op) < literalLength) {
+                return false;
+            }
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == ipEnd) {
+                break;
+            }
+
+            if (ipEnd - ip < 2) return false;
+            const size_t offset = ip[0] | (ip[1] << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+                return false;
+            }
+
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !ReadLength(matchLength, ip, ipEnd)) {
+                return false;
+            }
+            matchLength += MinMatch;
+            if (static_cast<size_t>(opEnd - op) < matchLength) {
+                return false;
+            }
+
+            const uint8_t *match = op - offset;
+            if (offset >= matchLength) {
+                std::memcpy(op, match, matchLength);
+                op += matchLength;
+            } else {
+                // Overlapping copy repeats the last offset bytes
+                for (size_t i = 0; i < matchLength; i++) {
+                    *op++ = *match++;
+                }
+            }
+        }
+        return op == opEnd;
+    }
+}
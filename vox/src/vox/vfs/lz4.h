@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Vox::LZ4 {
+    // Raw LZ4 block format, compatible with the reference implementation's LZ4_compress_default and
+    // LZ4_decompress_safe. There is no frame header; callers store the sizes themselves.
+
+    // Worst case compressed size of size bytes
+    constexpr size_t compressBound(const size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    // Greedy single-probe compressor. Returns the compressed size, or 0 if dst is too small.
+    size_t compress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstCapacity);
+
+    // Returns false if src is malformed or does not decompress to exactly dstSize bytes
+    bool decompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Vox {
+    // On-disk layout of a .pak archive written by vox-pak (little-endian):
+    //   PakHeader
+    //   PakEntry[entryCount], sorted by path (byte-wise) so lookups are a binary search
+    //   string table of entry paths, not null terminated, '/' separated and relative to the archive root
+    //   entry data, each entry aligned to PakDataAlignment
+    struct PakHeader {
+        static constexpr uint32_t Magic = 0x4b505856; // "VXPK"
+        static constexpr uint32_t Version = 1;
+
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t stringTableSize;
+        uint64_t stringTableOffset;
+        uint64_t reserved;
+    };
+
+    struct PakEntry {
+        enum Flags : uint32_t {
+            // Data is a raw LZ4 block, see Vox::LZ4
+            FlagLZ4 = 1 << 0,
+        };
+
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint64_t dataOffset;
+        // Bytes stored in the archive
+        uint32_t storedSize;
+        uint32_t size;
+        uint32_t flags;
+        uint32_t reserved;
+    };
+
+    static constexpr uint32_t PakDataAlignment = 16;
+}
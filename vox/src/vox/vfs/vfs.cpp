@@ -0,0 +1,269 @@
+#include "vox/vfs/vfs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "vox/vfs/embedded.h"
+#include "vox/vfs/lz4.h"
+#include "vox/vfs/pak.h"
+
+namespace Vox {
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string &path) {
+#if defined(_WIN32)
+            mFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (mFile == INVALID_HANDLE_VALUE) {
+                throw std::runtime_error("Could not open file '" + path + "'!");
+            }
+            LARGE_INTEGER size;
+            GetFileSizeEx(mFile, &size);
+            mSize = static_cast<size_t>(size.QuadPart);
+            mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mMapping) {
+                CloseHandle(mFile);
+                throw std::runtime_error("Could not map file '" + path + "'!");
+            }
+            mData = static_cast<const uint8_t *>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+            mFile = open(path.c_str(), O_RDONLY);
+            if (mFile < 0) {
+                throw std::runtime_error("Could not open file '" + path + "'!");
+            }
+            struct stat info{};
+            fstat(mFile, &info);
+            mSize = static_cast<size_t>(info.st_size);
+            void *data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mFile, 0);
+            mData = data == MAP_FAILED ? nullptr : static_cast<const uint8_t *>(data);
+#endif
+            if (!mData) {
+                close();
+                throw std::runtime_error("Could not map file '" + path + "'!");
+            }
+        }
+
+        ~MappedFile() {
+            close();
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const uint8_t *getData() const { return mData; }
+        size_t getSize() const { return mSize; }
+
+    private:
+        void close() {
+#if defined(_WIN32)
+            if (mData) UnmapViewOfFile(mData);
+            if (mMapping) CloseHandle(mMapping);
+            if (mFile != INVALID_HANDLE_VALUE) CloseHandle(mFile);
+            mMapping = nullptr;
+            mFile = INVALID_HANDLE_VALUE;
+#else
+            if (mData) munmap(const_cast<uint8_t *>(mData), mSize);
+            if (mFile >= 0) ::close(mFile);
+            mFile = -1;
+#endif
+            mData = nullptr;
+        }
+
+#if defined(_WIN32)
+        HANDLE mFile = INVALID_HANDLE_VALUE;
+        HANDLE mMapping = nullptr;
+#else
+        int mFile = -1;
+#endif
+        const uint8_t *mData = nullptr;
+        size_t mSize = 0;
+    };
+
+    class MountedArchive {
+    public:
+        explicit MountedArchive(const std::string &path) : mPath(path), mFile(path) {
+            const uint8_t *base = mFile.getData();
+            const size_t size = mFile.getSize();
+
+            if (size < sizeof(PakHeader)) {
+                throw std::runtime_error("'" + path + "' is not a pak archive!");
+            }
+            mHeader = reinterpret_cast<const PakHeader *>(base);
+            if (mHeader->magic != PakHeader::Magic) {
+                throw std::runtime_error("'" + path + "' is not a pak archive!");
+            }
+            if (mHeader->version != PakHeader::Version) {
+                throw std::runtime_error("Unsupported pak version in '" + path + "'!");
+            }
+
+            const uint64_t entriesEnd = sizeof(PakHeader) + static_cast<uint64_t>(mHeader->entryCount) *
+                                        sizeof(PakEntry);
+            if (entriesEnd > size || mHeader->stringTableOffset + mHeader->stringTableSize > size) {
+                throw std::runtime_error("Corrupt pak archive '" + path + "'!");
+            }
+            mEntries = reinterpret_cast<const PakEntry *>(base + sizeof(PakHeader));
+            mStrings = reinterpret_cast<const char *>(base + mHeader->stringTableOffset);
+
+            for (uint32_t i = 0; i < mHeader->entryCount; i++) {
+                const PakEntry &entry = mEntries[i];
+                // Stored entries are read as size bytes straight from the mapping
+                const bool stored = !(entry.flags & PakEntry::FlagLZ4);
+                if (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > mHeader->stringTableSize ||
+                    entry.dataOffset + entry.storedSize > size || (stored && entry.size != entry.storedSize)) {
+                    throw std::runtime_error("Corrupt pak archive '" + path + "'!");
+                }
+            }
+
+            mDecompressOnce = std::make_unique<std::once_flag[]>(mHeader->entryCount);
+            mDecompressed.resize(mHeader->entryCount);
+        }
+
+        // Index of the entry, or -1
+        int64_t find(const std::string_view path) const {
+            const PakEntry *end = mEntries + mHeader->entryCount;
+            const PakEntry *it = std::lower_bound(mEntries, end, path, [this](const PakEntry &entry,
+                                                                             const std::string_view value) {
+                return getPath(entry) < value;
+            });
+            return it != end && getPath(*it) == path ? it - mEntries : -1;
+        }
+
+        bool isCompressed(const uint32_t index) const {
+            return mEntries[index].flags & PakEntry::FlagLZ4;
+        }
+
+        VFSFile read(const uint32_t index) {
+            const PakEntry &entry = mEntries[index];
+            const uint8_t *stored = mFile.getData() + entry.dataOffset;
+            if (!isCompressed(index)) {
+                return { { stored, entry.size }, nullptr };
+            }
+
+            std::call_once(mDecompressOnce[index], [&] {
+                auto data = std::make_shared<std::vector<uint8_t>>(entry.size);
+                if (!LZ4::decompress(stored, entry.storedSize, data->data(), data->size())) {
+                    throw std::runtime_error("Corrupt entry '" + std::string(getPath(entry)) + "' in '" + mPath + "'!");
+                }
+                mDecompressed[index] = std::move(data);
+            });
+            const auto &data = mDecompressed[index];
+            return { { data->data(), data->size() }, data };
+        }
+
+    private:
+        std::string_view getPath(const PakEntry &entry) const {
+            return { mStrings + entry.pathOffset, entry.pathLength };
+        }
+
+        std::string mPath;
+        MappedFile mFile;
+        const PakHeader *mHeader = nullptr;
+        const PakEntry *mEntries = nullptr;
+        const char *mStrings = nullptr;
+
+        // Written once per entry under its once_flag and immutable afterwards
+        std::unique_ptr<std::once_flag[]> mDecompressOnce;
+        std::vector<std::shared_ptr<const std::vector<uint8_t>>> mDecompressed;
+    };
+
+    // Newest mount last; searched back to front
+    static std::vector<std::unique_ptr<MountedArchive>> sArchives;
+
+    static std::string NormalisePath(const std::string &path) {
+        return std::filesystem::path(path).lexically_normal().generic_string();
+    }
+
+    static std::pair<MountedArchive *, int64_t> FindEntry(const std::string &path) {
+        const std::string normalised = NormalisePath(path);
+        for (auto it = sArchives.rbegin(); it != sArchives.rend(); ++it) {
+            if (const int64_t index = (*it)->find(normalised); index >= 0) {
+                return { it->get(), index };
+            }
+        }
+        return { nullptr, -1 };
+    }
+
+    void VFS::mount(const std::string &archivePath) {
+        sArchives.push_back(std::make_unique<MountedArchive>(archivePath));
+    }
+
+    void VFS::unmountAll() {
+        sArchives.clear();
+    }
+
+    bool VFS::exists(const std::string &path) {
+        return EmbeddedFiles::find(NormalisePath(path)) || FindEntry(path).first ||
+               std::filesystem::is_regular_file(path);
+    }
+
+    VFSFile VFS::read(const std::string &path) {
+        if (const EmbeddedFile *file = EmbeddedFiles::find(NormalisePath(path))) {
+            return { file->data, nullptr };
+        }
+        if (const auto [archive, index] = FindEntry(path); archive) {
+            return archive->read(static_cast<uint32_t>(index));
+        }
+
+        std::ifstream in(path, std::ios::in | std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Could not open file '" + path + "'!");
+        }
+        in.seekg(0, std::ios::end);
+        auto data = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char *>(data->data()), static_cast<std::streamsize>(data->size()));
+        return { { data->data(), data->size() }, data };
+    }
+
+    void VFS::prefetch(const std::vector<std::string> &paths) {
+        std::vector<std::pair<MountedArchive *, uint32_t>> work;
+        for (const auto &path : paths) {
+            if (const auto [archive, index] = FindEntry(path); archive && archive->isCompressed(index)) {
+                work.emplace_back(archive, static_cast<uint32_t>(index));
+            }
+        }
+
+        std::atomic<size_t> next = 0;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        const auto worker = [&] {
+            for (size_t i = next++; i < work.size(); i = next++) {
+                try {
+                    work[i].first->read(work[i].second);
+                } catch (...) {
+                    std::lock_guard lock(errorMutex);
+                    error = std::current_exception();
+                }
+            }
+        };
+
+        const size_t threadCount = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), work.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < threadCount; i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
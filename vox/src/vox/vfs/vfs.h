@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vox {
+    // Contents of a file read through the VFS. Embedded files point into static storage and uncompressed archive
+    // entries straight into the archive mapping, which stays valid while it is mounted; anything else keeps its own
+    // buffer alive.
+    class VFSFile {
+    public:
+        VFSFile() = default;
+        VFSFile(std::span<const uint8_t> data, std::shared_ptr<const std::vector<uint8_t>> storage)
+            : mData(data), mStorage(std::move(storage)) {
+        }
+
+        std::span<const uint8_t> getData() const { return mData; }
+        std::string_view getText() const {
+            return { reinterpret_cast<const char *>(mData.data()), mData.size() };
+        }
+        size_t getSize() const { return mData.size(); }
+
+    private:
+        std::span<const uint8_t> mData;
+        std::shared_ptr<const std::vector<uint8_t>> mStorage;
+    };
+
+    // Read-only virtual file system. Files embedded into the binary (see EmbeddedFiles) are served first, without any
+    // I/O. Mounted .pak archives (see PakHeader) are memory mapped and searched newest first; paths not found in any
+    // archive fall back to the real file system, so loose files keep working during development. All reads are thread
+    // safe once mounting is done.
+    class VFS {
+    public:
+        static void mount(const std::string &archivePath);
+        static void unmountAll();
+
+        static bool exists(const std::string &path);
+        // Throws if the file does not exist. LZ4 compressed entries are decompressed on first read and cached.
+        static VFSFile read(const std::string &path);
+
+        // Decompresses the given archive entries across all cores so later reads are free
+        static void prefetch(const std::vector<std::string> &paths);
+    };
+}
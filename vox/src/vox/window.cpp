@@ -10,6 +10,7 @@
 #include "vox/events/key_event.h"
 
 #include "platform/opengl/context.h"
+#include "vox/renderer/render_thread.h"
 #include "vox/renderer/renderer.h"
 
 namespace Vox {
@@ -148,12 +149,21 @@ namespace Vox {
     }
 
     void Window::onUpdate() {
+        pollEvents();
+        swapBuffers();
+    }
+
+    void Window::pollEvents() {
         glfwPollEvents();
+    }
+
+    void Window::swapBuffers() {
         mContext->swapBuffers();
     }
 
     void Window::setVSync(bool enabled) {
-        glfwSwapInterval(enabled ? 1 : 0);
+        // Applies to the context current on the calling thread
+        RenderThread::submit([enabled] { glfwSwapInterval(enabled ? 1 : 0); });
         mVSync = enabled;
     }
 
@@ -17,6 +17,9 @@ namespace Vox {
         ~Window();
 
         void onUpdate();
+        // The two halves of onUpdate, for when the buffers are swapped on another thread
+        void pollEvents();
+        void swapBuffers();
 
         [[nodiscard]] inline unsigned int getWidth() const { return mWidth; }
 
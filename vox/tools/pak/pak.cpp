@@ -0,0 +1,157 @@
+// vox-pak: packs one or more directories into a .pak archive for Vox::VFS, see Vox::PakHeader.
+//
+//   vox-pak [--compress] <output> <directory>...
+//
+// Paths are stored relative to their directory, so later directories override files with the same path in earlier
+// ones. With --compress, entries are LZ4 compressed when it saves at least 10%.
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "vox/vfs/lz4.h"
+#include "vox/vfs/pak.h"
+
+using Vox::PakEntry;
+using Vox::PakHeader;
+
+struct Options {
+    std::string output;
+    std::vector<std::string> directories;
+    bool compress = false;
+};
+
+static Options ParseOptions(const int argc, char **argv) {
+    Options options;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--compress") {
+            options.compress = true;
+        } else if (arg.starts_with("--")) {
+            throw std::runtime_error("Unknown option '" + arg + "'!");
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() < 2) {
+        throw std::runtime_error("Usage: vox-pak [--compress] <output> <directory>...");
+    }
+    options.output = positional[0];
+    options.directories.assign(positional.begin() + 1, positional.end());
+    return options;
+}
+
+static std::vector<uint8_t> ReadFile(const std::filesystem::path &path) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open file '" + path.string() + "'!");
+    }
+    in.seekg(0, std::ios::end);
+    std::vector<uint8_t> data(static_cast<size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    return data;
+}
+
+int main(const int argc, char **argv) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+
+        // std::map keeps the paths in byte-wise order, which is what the runtime binary search expects
+        std::map<std::string, std::filesystem::path> files;
+        for (const auto &directory : options.directories) {
+            if (!std::filesystem::is_directory(directory)) {
+                throw std::runtime_error("'" + directory + "' is not a directory!");
+            }
+            for (const auto &file : std::filesystem::recursive_directory_iterator(directory)) {
+                if (file.is_regular_file()) {
+                    files[file.path().lexically_relative(directory).generic_string()] = file.path();
+                }
+            }
+        }
+
+        std::vector<PakEntry> entries;
+        std::string strings;
+        for (const auto &[path, source] : files) {
+            PakEntry entry{};
+            entry.pathOffset = static_cast<uint32_t>(strings.size());
+            entry.pathLength = static_cast<uint32_t>(path.size());
+            entries.push_back(entry);
+            strings += path;
+        }
+
+        PakHeader header{};
+        header.magic = PakHeader::Magic;
+        header.version = PakHeader::Version;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.stringTableSize = static_cast<uint32_t>(strings.size());
+        header.stringTableOffset = sizeof(PakHeader) + entries.size() * sizeof(PakEntry);
+
+        std::ofstream out(options.output, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Could not open file '" + options.output + "'!");
+        }
+
+        // Directory is written last, once the data offsets are known
+        uint64_t offset = header.stringTableOffset + strings.size();
+        out.seekp(static_cast<std::streamoff>(header.stringTableOffset));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+        size_t index = 0;
+        uint64_t totalSize = 0, totalStored = 0;
+        std::vector<uint8_t> compressed;
+        for (const auto &[path, source] : files) {
+            const auto data = ReadFile(source);
+            if (data.size() > UINT32_MAX) {
+                throw std::runtime_error("'" + path + "' is too large to pack!");
+            }
+
+            PakEntry &entry = entries[index++];
+            entry.size = static_cast<uint32_t>(data.size());
+            entry.storedSize = entry.size;
+            const uint8_t *stored = data.data();
+
+            if (options.compress && !data.empty()) {
+                compressed.resize(Vox::LZ4::compressBound(data.size()));
+                const size_t compressedSize = Vox::LZ4::compress(data.data(), data.size(), compressed.data(),
+                                                                 compressed.size());
+                if (compressedSize != 0 && compressedSize < data.size() / 10 * 9) {
+                    entry.storedSize = static_cast<uint32_t>(compressedSize);
+                    entry.flags |= PakEntry::FlagLZ4;
+                    stored = compressed.data();
+                }
+            }
+
+            offset = (offset + Vox::PakDataAlignment - 1) / Vox::PakDataAlignment * Vox::PakDataAlignment;
+            entry.dataOffset = offset;
+            out.seekp(static_cast<std::streamoff>(offset));
+            out.write(reinterpret_cast<const char *>(stored), entry.storedSize);
+            offset += entry.storedSize;
+
+            totalSize += entry.size;
+            totalStored += entry.storedSize;
+        }
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(entries.data()),
+                  static_cast<std::streamsize>(entries.size() * sizeof(PakEntry)));
+        if (!out) {
+            throw std::runtime_error("Failed to write '" + options.output + "'!");
+        }
+
+        std::cout << "vox-pak: " << entries.size() << " files, " << totalSize << " -> " << totalStored << " bytes"
+                  << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << "vox-pak: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
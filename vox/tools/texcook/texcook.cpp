@@ -0,0 +1,373 @@
+// vox-texcook: converts a source image into a .vxt texture container with a precomputed mip chain and block
+// compressed levels, see Vox::TextureContainer.
+//
+//   vox-texcook [--format auto|bc1|bc3|rgba8] [--srgb] [--no-mips] [--premultiply] <input> <output>
+//
+// auto picks BC3 for images with any transparency and BC1 otherwise.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "vox/image/image_ops.h"
+#include "vox/renderer/texture_container.h"
+
+using Vox::TextureContainer;
+using Vox::TextureContainerFormat;
+
+struct Image {
+    uint32_t width, height;
+    // RGBA8, rows bottom-up
+    std::vector<uint8_t> pixels;
+};
+
+struct Options {
+    std::string input, output;
+    std::string format = "auto";
+    bool sRGB = false;
+    bool mips = true;
+    bool premultiplyAlpha = false;
+};
+
+// 2x2 box filter. Colour is averaged in linear space for sRGB images so mips do not darken.
+static Image Downsample(const Image &source, const bool sRGB) {
+    Image result;
+    result.width = std::max(1u, source.width / 2);
+    result.height = std::max(1u, source.height / 2);
+    result.pixels.resize(static_cast<size_t>(result.width) * result.height * 4);
+    Vox::ImageOps::downsample(source.pixels.data(), source.width, source.height, result.pixels.data(), sRGB);
+    return result;
+}
+
+static uint16_t PackColor565(const float *rgb) {
+    const auto quantize = [](const float value, const float max) {
+        return static_cast<uint32_t>(std::clamp(value / 255.0f * max + 0.5f, 0.0f, max));
+    };
+    return static_cast<uint16_t>((quantize(rgb[0], 31.0f) << 11) | (quantize(rgb[1], 63.0f) << 5) |
+                                 quantize(rgb[2], 31.0f));
+}
+
+static void UnpackColor565(const uint16_t color, int *rgb) {
+    const int r = (color >> 11) & 0x1f;
+    const int g = (color >> 5) & 0x3f;
+    const int b = color & 0x1f;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Picks the nearest of the four palette entries for every texel and returns the total squared error
+static int SelectColorIndices(const uint8_t texels[16][4], const uint16_t c0, const uint16_t c1, uint32_t &indices) {
+    int palette[4][3];
+    UnpackColor565(c0, palette[0]);
+    UnpackColor565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    indices = 0;
+    int totalError = 0;
+    for (int i = 0; i < 16; i++) {
+        int best = 0, bestError = INT32_MAX;
+        for (int p = 0; p < 4; p++) {
+            int error = 0;
+            for (int c = 0; c < 3; c++) {
+                const int d = texels[i][c] - palette[p][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = p;
+            }
+        }
+        indices |= static_cast<uint32_t>(best) << (2 * i);
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+// Least squares fit of both endpoints to the texels, keeping the current index assignment
+static bool RefineEndpoints(const uint8_t texels[16][4], const uint32_t indices, float *maxColor, float *minColor) {
+    static constexpr float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = {}, bx[3] = {};
+    for (int i = 0; i < 16; i++) {
+        const float a = weights[(indices >> (2 * i)) & 3];
+        const float b = 1.0f - a;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (int c = 0; c < 3; c++) {
+            ax[c] += a * texels[i][c];
+            bx[c] += b * texels[i][c];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < 3; c++) {
+        maxColor[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        minColor[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// Endpoints start at the extremes of the texels projected onto their principal axis and are then refined by least
+// squares. The block is always written in four colour mode (c0 > c1), which is also what BC3 requires.
+static void EncodeColorBlock(const uint8_t texels[16][4], uint8_t *out) {
+    float mean[3] = {};
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            mean[c] += texels[i][c] / 16.0f;
+        }
+    }
+
+    float covariance[3][3] = {};
+    for (int i = 0; i < 16; i++) {
+        const float d[3] = { texels[i][0] - mean[0], texels[i][1] - mean[1], texels[i][2] - mean[2] };
+        for (int a = 0; a < 3; a++) {
+            for (int b = 0; b < 3; b++) {
+                covariance[a][b] += d[a] * d[b];
+            }
+        }
+    }
+
+    // A few rounds of power iteration are plenty for a 3x3 matrix
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[3] = {};
+        for (int a = 0; a < 3; a++) {
+            for (int b = 0; b < 3; b++) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+        }
+        const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+        if (length < 1e-6f) {
+            break;
+        }
+        for (int c = 0; c < 3; c++) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float minProjection = 1e9f, maxProjection = -1e9f;
+    int minTexel = 0, maxTexel = 0;
+    for (int i = 0; i < 16; i++) {
+        const float projection = texels[i][0] * axis[0] + texels[i][1] * axis[1] + texels[i][2] * axis[2];
+        if (projection < minProjection) {
+            minProjection = projection;
+            minTexel = i;
+        }
+        if (projection > maxProjection) {
+            maxProjection = projection;
+            maxTexel = i;
+        }
+    }
+
+    float maxColor[3], minColor[3];
+    for (int c = 0; c < 3; c++) {
+        maxColor[c] = texels[maxTexel][c];
+        minColor[c] = texels[minTexel][c];
+    }
+
+    uint16_t c0 = 0, c1 = 0;
+    uint32_t indices = 0;
+    int bestError = INT32_MAX;
+    for (int pass = 0; pass < 3; pass++) {
+        uint16_t candidate0 = PackColor565(maxColor);
+        uint16_t candidate1 = PackColor565(minColor);
+        if (candidate0 < candidate1) {
+            std::swap(candidate0, candidate1);
+        }
+
+        if (candidate0 == candidate1) {
+            // Solid block, every texel uses c0
+            if (pass == 0) {
+                c0 = c1 = candidate0;
+            }
+            break;
+        }
+
+        uint32_t candidateIndices = 0;
+        const int error = SelectColorIndices(texels, candidate0, candidate1, candidateIndices);
+        if (error >= bestError) {
+            break;
+        }
+        bestError = error;
+        c0 = candidate0;
+        c1 = candidate1;
+        indices = candidateIndices;
+
+        // Index 0 is c0 after the swap above, so the refined maxColor is the new c0
+        if (!RefineEndpoints(texels, indices, maxColor, minColor)) {
+            break;
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(c0);
+    out[1] = static_cast<uint8_t>(c0 >> 8);
+    out[2] = static_cast<uint8_t>(c1);
+    out[3] = static_cast<uint8_t>(c1 >> 8);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+// Eight-value mode between the block's minimum and maximum alpha
+static void EncodeAlphaBlock(const uint8_t texels[16][4], uint8_t *out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; i++) {
+        a0 = std::max<int>(a0, texels[i][3]);
+        a1 = std::min<int>(a1, texels[i][3]);
+    }
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8] = { a0, a1 };
+        for (int i = 1; i < 7; i++) {
+            palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+        }
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestError = INT32_MAX;
+            for (int p = 0; p < 8; p++) {
+                const int error = std::abs(texels[i][3] - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(a0);
+    out[1] = static_cast<uint8_t>(a1);
+    for (int i = 0; i < 6; i++) {
+        out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+
+static std::vector<uint8_t> EncodeLevel(const Image &image, const TextureContainerFormat format) {
+    if (format == TextureContainerFormat::RGBA8) {
+        return image.pixels;
+    }
+
+    std::vector<uint8_t> result(TextureContainer::getLevelSize(format, image.width, image.height));
+    const uint32_t blocksX = (image.width + 3) / 4;
+    const uint32_t blocksY = (image.height + 3) / 4;
+    const uint32_t blockSize = format == TextureContainerFormat::BC1 ? 8 : 16;
+
+    uint8_t texels[16][4];
+    for (uint32_t by = 0; by < blocksY; by++) {
+        for (uint32_t bx = 0; bx < blocksX; bx++) {
+            // Edge blocks repeat the last row/column rather than pulling unrelated colours into the endpoints
+            for (uint32_t y = 0; y < 4; y++) {
+                for (uint32_t x = 0; x < 4; x++) {
+                    const uint32_t sx = std::min(bx * 4 + x, image.width - 1);
+                    const uint32_t sy = std::min(by * 4 + y, image.height - 1);
+                    std::memcpy(texels[y * 4 + x], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+                }
+            }
+
+            uint8_t *block = &result[(by * blocksX + bx) * blockSize];
+            if (format == TextureContainerFormat::BC1) {
+                EncodeColorBlock(texels, block);
+            } else {
+                EncodeAlphaBlock(texels, block);
+                EncodeColorBlock(texels, block + 8);
+            }
+        }
+    }
+    return result;
+}
+
+// Containers are stored bottom-up, which is how ImageOps::decode returns rows
+static Image LoadImage(const std::string &path, const bool premultiplyAlpha) {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Could not open file '" + path + "'!");
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Vox::ImageOps::DecodeOptions options;
+    options.premultiplyAlpha = premultiplyAlpha;
+    auto decoded = Vox::ImageOps::decode(data, options);
+    return { decoded.width, decoded.height, std::move(decoded.pixels) };
+}
+
+static TextureContainerFormat SelectFormat(const std::string &name, const Image &image) {
+    if (name == "bc1") return TextureContainerFormat::BC1;
+    if (name == "bc3") return TextureContainerFormat::BC3;
+    if (name == "rgba8") return TextureContainerFormat::RGBA8;
+    if (name != "auto") {
+        throw std::runtime_error("Unknown format '" + name + "'!");
+    }
+
+    for (size_t i = 3; i < image.pixels.size(); i += 4) {
+        if (image.pixels[i] != 255) {
+            return TextureContainerFormat::BC3;
+        }
+    }
+    return TextureContainerFormat::BC1;
+}
+
+static Options ParseOptions(const int argc, char **argv) {
+    Options options;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+        } else if (arg == "--srgb") {
+            options.sRGB = true;
+        } else if (arg == "--no-mips") {
+            options.mips = false;
+        } else if (arg == "--premultiply") {
+            options.premultiplyAlpha = true;
+        } else if (arg.starts_with("--")) {
+            throw std::runtime_error("Unknown option '" + arg + "'!");
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.size() != 2) {
+        throw std::runtime_error("Usage: vox-texcook [--format auto|bc1|bc3|rgba8] [--srgb] [--no-mips] [--premultiply] <input> <output>");
+    }
+    options.input = positional[0];
+    options.output = positional[1];
+    return options;
+}
+
+int main(const int argc, char **argv) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+
+        Image image = LoadImage(options.input, options.premultiplyAlpha);
+        const TextureContainerFormat format = SelectFormat(options.format, image);
+
+        TextureContainer container(format, image.width, image.height, options.sRGB);
+        while (true) {
+            const auto level = EncodeLevel(image, format);
+            container.addLevel(image.width, image.height, level.data(), static_cast<uint32_t>(level.size()));
+            if (!options.mips || (image.width == 1 && image.height == 1)) {
+                break;
+            }
+            image = Downsample(image, options.sRGB);
+        }
+
+        container.save(options.output);
+    } catch (const std::exception &e) {
+        std::cerr << "vox-texcook: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}